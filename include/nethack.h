@@ -61,9 +61,18 @@ extern EXPORT nh_bool nh_view_replay_step(struct nh_replay_info *info,
                                           enum replay_control action,
                                           int count);
 extern EXPORT void nh_view_replay_finish(void);
+extern EXPORT void nh_view_replay_verify(nh_bool verify);
+extern EXPORT void nh_view_replay_checkpoint_memory(unsigned long long bytes);
 extern EXPORT enum nh_log_status nh_get_savegame_status(
   int fd, struct nh_game_info *si);
 
+/* bench.c */
+extern EXPORT void nh_bench_fix_seed(nh_bool fixed, unsigned int seed,
+                                     unsigned long long gametime);
+extern EXPORT void nh_bench_enable(nh_bool enable);
+extern EXPORT void nh_bench_reset(void);
+extern EXPORT void nh_bench_get_stats(struct nh_bench_stats *stats);
+
 /* cmd.c */
 extern EXPORT struct nh_cmd_desc *nh_get_commands(int *count);
 extern EXPORT struct nh_cmd_desc *nh_get_object_commands(int *count,
@@ -54,6 +54,14 @@ struct nhnet_server_version {
 extern EXPORT struct nhnet_server_version nhnet_server_ver;
 
 
+/* one command for nhnet_command_batch */
+struct nhnet_queued_command {
+    const char *cmd;
+    int rep;
+    struct nh_cmd_arg arg;
+};
+
+
 extern EXPORT int nhnet_connect(const char *host, int port, const char *user,
                                 const char *pass, const char *email,
                                 int reg_user);
@@ -73,6 +81,8 @@ extern EXPORT nh_bool nhnet_start_game(const char *name, int role, int race,
                                        enum nh_game_modes playmode);
 extern EXPORT int nhnet_command(const char *cmd, int rep,
                                 struct nh_cmd_arg *arg);
+extern EXPORT int nhnet_command_batch(const struct nhnet_queued_command *cmds,
+                                      int ncmds, int *ndone);
 extern EXPORT const char *const *nhnet_get_copyright_banner(void);
 extern EXPORT nh_bool nhnet_view_replay_start(int fd,
                                               struct nh_window_procs *rwinprocs,
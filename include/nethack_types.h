@@ -281,6 +281,27 @@ enum replay_control {
     REPLAY_GOTO
 };
 
+/* code sections timed by the benchmark hooks in bench.c */
+enum nh_bench_phase {
+    BENCH_LEVEL_CREATION,       /* mklev() */
+    BENCH_MOVEMON,      /* movemon() */
+    BENCH_VISION,       /* vision_recalc() */
+    BENCH_FLUSH_SCREEN, /* flush_screen() */
+    BENCH_LOG_RESULT,   /* log_command_result() */
+    BENCH_PREGEN_TAKE,  /* pregen_take_level() with a worker to ask */
+    BENCH_PHASE_COUNT
+};
+
+/* events counted by the benchmark hooks */
+enum nh_bench_counter {
+    BENCH_MONLIST_WALKS,        /* whole monster lists searched for monsters
+                                   near the hero (travel interruption) */
+    BENCH_NEARBY_MONSTERS,      /* monsters examined by those searches */
+    BENCH_PREGEN_HITS,  /* levels made by a pregen_levels worker used */
+    BENCH_PREGEN_MISSES,        /* and thrown away */
+    BENCH_COUNTER_COUNT
+};
+
 enum placement_hint {
     PLHINT_ANYWHERE,
     PLHINT_LEFT,
@@ -385,6 +406,12 @@ struct nh_objitem {
     nh_bool worn;
 };
 
+/* identifies an inventory entry across calls of win_update_inventory: the
+   inventory letter for items, the negated class symbol for class headings */
+# define NH_OBJITEM_KEY(item) ((item)->role == MI_HEADING ? \
+                               -(int)(unsigned char)(item)->group_accel : \
+                               (item)->id)
+
 struct nh_objresult {
     int id;
     int count;
@@ -456,6 +483,14 @@ struct nh_replay_info {
     char nextcmd[64];
     int actions, max_actions;
     int moves, max_moves;
+    int desyncs;        /* diffs that didn't match the replay so far */
+};
+
+
+struct nh_bench_stats {
+    unsigned long long calls[BENCH_PHASE_COUNT];
+    unsigned long long nsec[BENCH_PHASE_COUNT]; /* inclusive wall time */
+    unsigned long long count[BENCH_COUNTER_COUNT];
 };
 
 
@@ -625,6 +660,14 @@ struct nh_window_procs {
                         nh_bool tombstone, const char *name, int gold,
                         const char *killbuf, int end_how, int year);
     void (*win_print_message_nonblocking) (int turn, const char *msg);
+
+    /* Optional.  If set, inventory changes after the first full list sent via
+       win_list_items are reported here instead: order holds the keys (see
+       NH_OBJITEM_KEY) of all icount entries of the new inventory, changed
+       holds only the entries that are new or differ from the previous call.
+       Entries whose keys are missing from order have been removed. */
+    void (*win_update_inventory) (struct nh_objitem * changed, int nchanged,
+                                  int *order, int icount);
 };
 
 #endif
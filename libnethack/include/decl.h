@@ -298,7 +298,6 @@ extern struct permonst pm_you_male, pm_you_female;
 extern int exit_jmp_buf_valid;
 extern nh_jmp_buf exit_jmp_buf;
 
-extern struct artifact *artilist;
 extern short disco[NUM_OBJECTS];
 
 struct cmd_desc {
@@ -410,6 +409,10 @@ struct memfile {
     /* Tags to help in diffing. This is a hashtable for efficiency, using
        chaining in the case of collisions */
     struct memfile_tag *tags[MEMFILE_HASHTABLE_SIZE];
+    /* Memfiles made by mmapfd may have buf pointing into a mapping of a file
+       instead of the heap; mapbase and maplen describe the mapping */
+    void *mapbase;
+    size_t maplen;
 };
 
 extern int logfile;
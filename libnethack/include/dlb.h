@@ -22,6 +22,10 @@ typedef struct dlb_library {
     long nentries;      /* # of files in directory */
     long rev;   /* dlb file revision */
     long strsize;       /* dlb file string size */
+    int *hash;  /* directory indices by file name hash, -1 if unused */
+    int hashsize;       /* power of 2, at least twice nentries */
+    const char *mapped; /* the whole library file, if it is mmapped */
+    long mapsize;
 } library;
 
 /* library definitions */
@@ -31,6 +35,11 @@ typedef struct dlb_library {
 # endif
 # ifndef FILENAME_CMP
 #  define FILENAME_CMP  strcmp  /* case sensitive */
+#  define FILENAME_FOLD(c)      (c)
+# endif
+/* a port that compares names without case must hash them without case */
+# ifndef FILENAME_FOLD
+#  define FILENAME_FOLD(c)      tolower(c)
 # endif
 
 
@@ -38,6 +47,7 @@ typedef struct dlb_library {
 typedef struct dlb_handle {
     FILE *fp;   /* pointer to an external file, use if non-null */
     library *lib;       /* pointer to library structure */
+    const char *mem;    /* contents of a preloaded file, use if non-null */
     long start; /* offset of start of file */
     long size;  /* size of file */
     long mark;  /* current file marker */
@@ -47,6 +57,8 @@ typedef struct dlb_handle {
 
 boolean dlb_init(void);
 void dlb_cleanup(void);
+boolean dlb_preload(const char *);
+void dlb_free_preloaded(void);
 
 dlb *dlb_fopen(const char *, const char *);
 int dlb_fclose(DLB_P);
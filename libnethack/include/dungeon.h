@@ -97,6 +97,8 @@ struct overview_info {
     schar shoptype;     /* -1: multiple shops */
     boolean branch, portal;     /* branch, magic portal on this level */
     struct d_level branch_dst, portal_dst;      /* where to? */
+    boolean forgotten;  /* the level's flags.forgotten */
+    char levname[64];   /* the level's name given by the player */
 };
 
 
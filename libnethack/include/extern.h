@@ -12,6 +12,8 @@
 extern void stop_occupation(void);
 extern void startup_common(const char *name, int playmode);
 extern int command_input(int cmdidx, int rep, struct nh_cmd_arg *arg);
+extern void continue_command(struct nh_cmd_arg *arg);
+extern void fast_forward_unwind(void);
 
 /* ### apply.c ### */
 
@@ -102,6 +104,15 @@ extern boolean drag_ball(xchar, xchar, int *, xchar *, xchar *, xchar *,
 extern void drop_ball(xchar, xchar, schar, schar);
 extern void drag_down(void);
 
+/* ### bench.c ### */
+
+extern boolean bench_fixed_seed(unsigned int *seed,
+                                unsigned long long *gametime);
+extern void bench_start(enum nh_bench_phase phase);
+extern void bench_stop(enum nh_bench_phase phase);
+extern void bench_count(enum nh_bench_counter counter, int n);
+extern void bench_unwind(void);
+
 /* ### bones.c ### */
 
 extern boolean can_make_bones(d_level * lev);
@@ -132,6 +143,16 @@ extern void confdir(schar * dx, schar * dy);
 extern int get_adjacent_loc(const char *, const char *, xchar, xchar, coord *,
                             schar *);
 
+/* ### coldlev.c ### */
+
+extern struct level *level_by_ledger(xchar ledger);
+extern boolean level_exists(xchar ledger);
+extern boolean level_is_cold(xchar ledger);
+extern boolean level_overview(xchar ledger, struct overview_info *oi);
+extern void freeze_idle_levels(void);
+extern void save_cold_level(struct memfile *mf, xchar ledger);
+extern void free_cold_levels(void);
+
 /* ### dbridge.c ### */
 
 extern boolean is_pool(struct level *lev, int x, int y);
@@ -390,6 +411,7 @@ extern void dump_catch_menus(boolean intercept);
 
 /* ### dungeon.c ### */
 
+extern void free_branches(void);
 extern void free_dungeon(void);
 extern void save_d_flags(struct memfile *mf, d_flags f);
 extern void save_dungeon(struct memfile *mf);
@@ -407,6 +429,7 @@ extern xchar dunlev(const d_level *);
 extern xchar dunlevs_in_dungeon(const d_level *);
 extern xchar ledger_to_dnum(xchar);
 extern xchar ledger_to_dlev(xchar);
+extern void overview_scan(const struct level *lev, struct overview_info *oi);
 extern xchar deepest_lev_reached(boolean);
 extern boolean on_level(const d_level *, const d_level *);
 extern void next_level(boolean);
@@ -671,6 +694,7 @@ extern char *xprname(struct obj *, const char *, char, boolean, long, long);
 extern int ddoinv(void);
 extern char display_inventory(const char *, boolean);
 extern void update_inventory(void);
+extern void free_invent_cache(void);
 extern int display_binventory(int, int, boolean);
 extern struct obj *display_cinventory(struct obj *);
 extern struct obj *display_minventory(struct monst *, int, char *);
@@ -741,6 +765,7 @@ extern void log_newgame(int logfd, unsigned long long start_time,
                         unsigned int seed, int playmode);
 extern void log_command(int cmd, int count, struct nh_cmd_arg *arg);
 extern void log_timezone(int tz_offset);
+extern void log_command_continued(void);
 extern void log_command_result(void);
 extern void log_revert_command(void);
 extern void log_option(struct nh_option_desc *opt);
@@ -815,6 +840,8 @@ extern int castum(struct monst *, const struct attack *);
 
 extern void mnew(struct memfile *mf, struct memfile *relativeto);
 extern void mfree(struct memfile *mf);
+extern boolean mmapfd(struct memfile *mf, int fd);
+extern boolean mreadfd(struct memfile *mf, int fd, int len);
 extern void mwrite(struct memfile *mf, const void *buf, unsigned int num);
 extern void mwrite8(struct memfile *mf, int8_t value);
 extern void mwrite16(struct memfile *mf, int16_t value);
@@ -943,6 +970,8 @@ extern void blessorcurse(struct obj *, int);
 extern boolean is_flammable(const struct obj *);
 extern boolean is_rottable(const struct obj *);
 extern void place_object(struct obj *otmp, struct level *lev, int x, int y);
+extern int floor_objects_in_box(struct level *lev, int lx, int ly, int hx,
+                                int hy, struct obj ***objs_p);
 extern void remove_object(struct obj *);
 extern void discard_minvent(struct monst *);
 extern void obj_extract_self(struct obj *);
@@ -1211,6 +1240,8 @@ extern int doquickwhatis(void);
 extern int doidtrap(void);
 extern int dolicense(void);
 extern int doverhistory(void);
+extern void free_dbase_index(void);
+extern boolean load_dbase_index(void);
 
 /* ### pickup.c ### */
 
@@ -1234,6 +1265,7 @@ extern int use_container(struct obj *, int);
 extern int loot_mon(struct monst *, int *, boolean *);
 extern const char *safe_qbuf(const char *, unsigned, const char *, const char *,
                              const char *);
+extern void reset_autopickup_matcher(void);
 
 /* ### pline.c ### */
 
@@ -1309,6 +1341,14 @@ extern const char *align_gtitle(aligntyp);
 extern void altar_wrath(int, int);
 
 
+/* ### pregen.c ### */
+
+extern void pregen_discard(void);
+extern void pregen_after_command(void);
+extern void pregen_worker_abort(void);
+extern struct level *pregen_take_level(d_level * newlevel);
+
+
 /* ### priest.c ### */
 
 extern int move_special(struct monst *, boolean, schar, boolean, boolean, xchar,
@@ -1427,6 +1467,8 @@ extern int doconsult(struct monst *);
 extern int dosave(void);
 extern int dosave0(boolean emergency);
 extern void savegame(struct memfile *mf);
+extern void save_header(struct memfile *mf);
+extern int savegame_header_size(void);
 extern void savelev(struct memfile *mf, xchar levnum);
 extern void freelev(xchar levnum);
 extern void savefruitchn(struct memfile *mf);
@@ -1510,6 +1552,13 @@ extern void rndcurse(void);
 extern void mrndcurse(struct monst *);
 extern void attrcurse(void);
 
+/* ### slab.c ### */
+
+extern void *slab_alloc(size_t size);
+extern void slab_free(void *ptr);
+extern void slab_reset(void);
+extern void slab_release(void);
+
 /* ### sounds.c ### */
 
 extern void dosounds(void);
@@ -118,6 +118,9 @@ struct instance_flags {
     boolean vision_inited;      /* true if vision is ready */
     int purge_monsters; /* # of dead monsters still on level->monlist list */
     boolean pickup_thrown;      /* auto-pickup items you threw */
+    boolean pregen_levels;      /* make the level past the stairs early */
+    int cold_levels;    /* compress levels left this many turns ago */
+    int fast_forward;   /* max. steps of a multi-turn command per call */
     boolean travel1;    /* first travel step */
     coord travelcc;     /* coordinates for travel_cache */
     boolean mon_polycontrol;    /* debug: control monster polymorphs */
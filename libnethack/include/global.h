@@ -28,6 +28,8 @@
 # define RUMORFILE     "rumors" /* file with fortune cookies */
 # define ORACLEFILE    "oracles"/* file with oracular information */
 # define DATAFILE      "data"   /* file giving the meaning of symbols used */
+# define DATAINDEXFILE "dataidx"        /* lookup index for DATAFILE */
+# define QTEXT_FILE    "quest.dat"      /* quest text messages */
 # define HISTORY       "history"/* file giving nethack's history */
 # define LICENSE       "license"/* file with license information */
 
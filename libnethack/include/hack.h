@@ -275,7 +275,9 @@ extern coord bhitpos;   /* place where throw or zap hits or stops */
  * this MUST be a macro: stack values get clobbered; this includes the return address
  */
 # define api_entry_checkpoint() \
-    (exit_jmp_buf_valid++ ? 1 : nh_setjmp(exit_jmp_buf) ? 0 : 1)
+    (exit_jmp_buf_valid++ ? 1 : \
+     nh_setjmp(exit_jmp_buf) ? \
+     (bench_unwind(), fast_forward_unwind(), 0) : 1)
 
 # define api_exit() do {--exit_jmp_buf_valid; } while(0)
 
@@ -7,6 +7,10 @@
 #ifndef LEV_H
 # define LEV_H
 
+/* Each map location is saved as 8 bytes: the remembered things (32 bits),
+   typ, seenv and the other flags (16 bits), all in little-endian order */
+# define SAVED_LOCATION_SIZE 8
+
 /* The following are used in mkmaze.c */
 struct container {
     struct container *next;
@@ -160,7 +160,7 @@ struct monst {
  * exception being the guardian angels which are tame on creation).
  */
 
-# define dealloc_monst(mon) free((mon))
+# define dealloc_monst(mon) slab_free((mon))
 
 /* these are in mspeed */
 # define MSLOW 1/* slow monster */
@@ -104,11 +104,13 @@ struct obj {
     short oxlth;        /* length of following data */
     int age;    /* creation date */
     int owornmask;
+    unsigned long floorseq;     /* placement order on the floor chain; not
+                                   saved, rebuilt by place_object() */
     void *oextra[];     /* used for name of ordinary objects - length is
                            flexible; amount for tmp gold objects */
 };
 
-# define newobj(xl)     malloc((unsigned)(xl) + sizeof(struct obj))
+# define newobj(xl)     slab_alloc((unsigned)(xl) + sizeof(struct obj))
 # define ONAME(otmp)    (((char *)(otmp)->oextra) + (otmp)->oxlth)
 
 /* Weapons and weapon-tools */
@@ -293,8 +295,8 @@ struct obj {
                                  (obj)->otyp == TOUCHSTONE)
 
 /* misc */
-# define is_flimsy(otmp)      (objects[(otmp)->otyp].oc_material <= LEATHER || \
-                               (otmp)->otyp == RUBBER_HOSE)
+# define is_flimsy(otmp)     (objstate[(otmp)->otyp].oc_material <= LEATHER || \
+                              (otmp)->otyp == RUBBER_HOSE)
 
 /* helpers, simple enough to be macros */
 # define is_plural(o)   ((o)->quan > 1 || \
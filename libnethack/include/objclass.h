@@ -5,31 +5,23 @@
 #ifndef OBJCLASS_H
 # define OBJCLASS_H
 
-/* definition of a class of objects */
+/* definition of a class of objects; the parts of it that change in the course
+   of a game are in struct objstate */
 
 struct objclass {
-    short oc_name_idx;  /* index of actual name */
-    short oc_descr_idx; /* description when name unknown */
-    char *oc_uname;     /* called by user */
-    unsigned oc_name_known:1;
     unsigned oc_merge:1;        /* merge otherwise equal objects */
     unsigned oc_uses_known:1;   /* obj->known affects full decription */
     /* otherwise, obj->dknown and obj->bknown */
     /* tell all, and obj->known should always */
     /* be set for proper merging behavior */
-    unsigned oc_pre_discovered:1;       /* Already known at start of game; */
-    /* won't be listed as a discovery. */
     unsigned oc_magic:1;        /* inherently magical object */
     unsigned oc_charged:1;      /* may have +n or (n) charges */
     unsigned oc_unique:1;       /* special one-of-a-kind object */
     unsigned oc_nowish:1;       /* cannot wish for this object */
 
-    unsigned oc_disclose_id:1;  /* was identified by DYWYPI */
-
     unsigned oc_big:1;
 # define oc_bimanual    oc_big  /* for weapons & tools used as weapons */
 # define oc_bulky       oc_big  /* for armor */
-    unsigned oc_tough:1;        /* hard gems/rings */
 
     unsigned oc_dir:2;
 # define NODIR          1       /* for wands/spells: non-directional */
@@ -40,7 +32,7 @@ struct objclass {
 # define SLASH          2       /* (latter includes iron ball & chain) */
 # define WHACK          0
 
-    unsigned oc_material:5;
+/* values of oc_material in struct objstate */
 # define LIQUID         1       /* currently only for venom */
 # define WAX            2
 # define VEGGY          3       /* foodstuffs */
@@ -63,16 +55,17 @@ struct objclass {
 # define GEMSTONE       20
 # define MINERAL        21
 
-# define is_organic(otmp)       (objects[otmp->otyp].oc_material <= WOOD)
-# define is_metallic(otmp)      (objects[otmp->otyp].oc_material >= IRON && \
-                                 objects[otmp->otyp].oc_material <= MITHRIL)
+# define is_organic(otmp)       (objstate[otmp->otyp].oc_material <= WOOD)
+# define is_metallic(otmp)      (objstate[otmp->otyp].oc_material >= IRON && \
+                                 objstate[otmp->otyp].oc_material <= MITHRIL)
 
 /* primary damage: fire/rust/--- */
 /* is_flammable(otmp), is_rottable(otmp) in mkobj.c */
-# define is_rustprone(otmp)     (objects[otmp->otyp].oc_material == IRON)
+# define is_rustprone(otmp)     (objstate[otmp->otyp].oc_material == IRON)
 
 /* secondary damage: rot/acid/acid */
-# define is_corrodeable(otmp)   (objects[otmp->otyp].oc_material == COPPER || objects[otmp->otyp].oc_material == IRON)
+# define is_corrodeable(otmp)   (objstate[otmp->otyp].oc_material == COPPER || \
+                                 objstate[otmp->otyp].oc_material == IRON)
 
 # define is_damageable(otmp) (is_rustprone(otmp) || is_flammable(otmp) || \
                                 is_rottable(otmp) || is_corrodeable(otmp))
@@ -92,9 +85,7 @@ struct objclass {
     uchar oc_oprop;     /* property (invis, &c.) conveyed */
     char oc_class;      /* object class */
     schar oc_delay;     /* delay when using such an object */
-    uchar oc_color;     /* color of the object */
 
-    short oc_prob;      /* probability, used in mkobj() */
     unsigned short oc_weight;   /* encumbrance (1 cn = 0.1 lb.) */
     short oc_cost;      /* base cost in shops */
 /* Check the AD&D rules!  The FIRST is small monster damage. */
@@ -110,16 +101,35 @@ struct objclass {
     unsigned short oc_nutrition;        /* food value */
 };
 
+/* The parts of an object class that differ from game to game: what the hero
+   knows about it, and the description, color, material and hardness, which
+   get shuffled at the start of a game.  Gem probabilities depend on the depth
+   of the current level. */
+struct objstate {
+    char *oc_uname;     /* called by user */
+    short oc_descr_idx; /* description when name unknown */
+    short oc_prob;      /* probability, used in mkobj() */
+    unsigned oc_name_known:1;
+    unsigned oc_pre_discovered:1;       /* Already known at start of game; */
+    /* won't be listed as a discovery. */
+    unsigned oc_disclose_id:1;  /* was identified by DYWYPI */
+    unsigned oc_tough:1;        /* hard gems/rings */
+    unsigned oc_material:5;
+    uchar oc_color;     /* color of the object */
+};
+
 struct objdescr {
     const char *oc_name;        /* actual name */
     const char *oc_descr;       /* description when name unknown */
 };
 
-extern struct objclass *objects;
-extern const struct objclass const_objects[];
+extern const struct objclass objects[];
 extern const struct objdescr obj_descr[];
+extern const struct objstate const_objstate[];  /* for the start of a game */
+extern struct objstate objstate[];
+extern boolean objstate_valid;  /* FALSE until a game is set up */
 
-/* copy object list into objects */
+/* copy const_objstate into objstate */
 extern void init_objlist(void);
 
 /*
@@ -183,6 +193,6 @@ struct fruit {
 # define newfruit() malloc(sizeof(struct fruit))
 # define dealloc_fruit(rind) free(rind)
 
-# define OBJ_NAME(obj)  (obj_descr[(obj).oc_name_idx].oc_name)
-# define OBJ_DESCR(obj) (obj_descr[(obj).oc_descr_idx].oc_descr)
+# define OBJ_NAME(otyp)  (obj_descr[otyp].oc_name)
+# define OBJ_DESCR(otyp) (obj_descr[objstate[otyp].oc_descr_idx].oc_descr)
 #endif /* OBJCLASS_H */
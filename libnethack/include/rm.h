@@ -470,11 +470,15 @@ struct wseg {
 
 
 struct ls_t;
+# define MONBITS_WORDS ((COLNO + 63) / 64)
+
 struct level {
     char levname[64];   /* as given by the player via donamelevel */
     struct rm locations[COLNO][ROWNO];
     struct obj *objects[COLNO][ROWNO];
     struct monst *monsters[COLNO][ROWNO];
+    /* one bit per square, set where monsters[][] is (or may be) set */
+    unsigned long long monbits[ROWNO][MONBITS_WORDS];
     struct obj *objlist;
     struct obj *buriedobjlist;
     struct obj *billobjs;       /* objects not yet paid for */
@@ -524,8 +528,13 @@ extern struct level *level;             /* pointer to an entry in levels */
              ((lev)->monsters[x][y] != NULL && !(lev)->monsters[x][y]->mburied)
 # define MON_BURIED_AT(x,y) \
              (level->monsters[x][y] != NULL && level->monsters[x][y]->mburied)
-# define place_worm_seg(m,x,y)   (m)->dlevel->monsters[x][y] = m
-# define remove_monster(lev,x,y) (lev)->monsters[x][y] = NULL
+# define MONBIT(x)               (1ULL << ((x) % 64))
+# define set_monbit(lev,x,y)     ((lev)->monbits[y][(x) / 64] |= MONBIT(x))
+# define clear_monbit(lev,x,y)   ((lev)->monbits[y][(x) / 64] &= ~MONBIT(x))
+# define place_worm_seg(m,x,y) \
+             ((m)->dlevel->monsters[x][y] = (m), set_monbit((m)->dlevel,x,y))
+# define remove_monster(lev,x,y) \
+             ((lev)->monsters[x][y] = NULL, clear_monbit(lev,x,y))
 # define m_at(lev,x,y) \
              (MON_AT(lev,x,y) ? (lev)->monsters[x][y] : NULL)
 # define m_buried_at(x,y) \
@@ -23,6 +23,10 @@ static void pre_move_tasks(void);
 static void newgame(void);
 static void welcome(boolean);
 static void handle_lava_trap(boolean didmove);
+static void preload_text_files(void);
+
+static boolean text_files_loaded = FALSE;
+static boolean fast_forwarding; /* see continue_command() */
 
 
 static void
@@ -50,11 +54,18 @@ nh_lib_init(const struct nh_window_procs *procs, char **paths)
 
     windowprocs = *procs;
 
-    for (i = 0; i < PREFIX_COUNT; i++)
+    /* a process may call this again to change the paths or window procs
+       (e.g. the server preloads the data files before it forks, and each
+       child initializes itself again) */
+    for (i = 0; i < PREFIX_COUNT; i++) {
+        free(fqn_prefix[i]);
         fqn_prefix[i] = strdup(paths[i]);
+    }
 
     u.uhp = 1;  /* prevent RIP on early quits */
+    cleanup_opt_struct();
     init_opt_struct();
+    preload_text_files();
     turntime = 0;
 
     current_timezone = get_tz_offset();
@@ -76,6 +87,38 @@ nh_lib_exit(void)
     }
 
     cleanup_opt_struct();
+
+    free_dbase_index();
+    dlb_free_preloaded();
+    text_files_loaded = FALSE;
+
+    slab_release();
+}
+
+
+/* The text files are read-only for the whole life of the process, so they are
+ * read into memory once rather than opened again by every game (or, for
+ * rumors and oracles, every time one is needed).  Only the source of the bytes
+ * changes: callers still read and seek exactly as before, so the random
+ * numbers they use are the same.  A file that can't be loaded here is simply
+ * looked for again when it's opened. */
+static void
+preload_text_files(void)
+{
+    static const char *const text_files[] = {
+        RUMORFILE, ORACLEFILE, QTEXT_FILE, DATAFILE, DATAINDEXFILE
+    };
+    int i;
+
+    if (text_files_loaded || !dlb_init())
+        return;
+
+    for (i = 0; i < SIZE(text_files); i++)
+        dlb_preload(text_files[i]);
+    load_dbase_index();
+
+    dlb_cleanup();
+    text_files_loaded = TRUE;
 }
 
 
@@ -151,7 +194,7 @@ startup_common(const char *name, int playmode)
     reset_steal();
     reset_dig_status();
 
-    /* create mutable copies of object and artifact liss */
+    /* reset the per-game state of object classes and artifacts */
     init_objlist();
     init_artilist();
     reset_rndmonst(NON_PM);
@@ -250,8 +293,10 @@ nh_start_game(int fd, const char *name, int irole, int irace, int igend,
         goto err_out;
 
     if (!program_state.restoring) {
-        turntime = (unsigned long long)time(NULL);
-        seed = turntime ^ get_seedval();
+        if (!bench_fixed_seed(&seed, &turntime)) {
+            turntime = (unsigned long long)time(NULL);
+            seed = turntime ^ get_seedval();
+        }
         /* initialize the random number generator */
         mt_srand(seed);
     }
@@ -419,7 +464,9 @@ you_moved(void)
 
         flags.mon_moving = TRUE;
         do {
+            bench_start(BENCH_MOVEMON);
             monscanmove = movemon();
+            bench_stop(BENCH_MOVEMON);
             if (youmonst.movement > NORMAL_SPEED)
                 break;  /* it's now your turn */
         } while (monscanmove);
@@ -746,7 +793,7 @@ pre_move_tasks(void)
     if (!flags.mv || Blind)
         special_vision_handling();
 
-    if (iflags.botl)
+    if (iflags.botl && !fast_forwarding)
         bot();
 
     if ((u.uhave.amulet || Clairvoyant) && !In_endgame(&u.uz) && !BClairvoyant
@@ -809,7 +856,7 @@ command_input(int cmdidx, int rep, struct nh_cmd_arg *arg)
     if (vision_full_recalc)
         vision_recalc(0);       /* vision! */
     /* when running in non-tport mode, this gets done through domove() */
-    if ((!flags.run || iflags.runmode == RUN_TPORT) &&
+    if ((!flags.run || iflags.runmode == RUN_TPORT) && !fast_forwarding &&
         (multi && (!flags.travel ? !(multi % 7) : !(moves % 7L)))) {
         if (flags.run)
             iflags.botl = 1;
@@ -826,6 +873,7 @@ command_input(int cmdidx, int rep, struct nh_cmd_arg *arg)
     /* once-per-player-input things go here */
      /****************************************/
     xmalloc_cleanup();
+    freeze_idle_levels();
     iflags.next_msg_nonblocking = 0;
 
     /* prepare for the next move */
@@ -838,13 +886,46 @@ command_input(int cmdidx, int rep, struct nh_cmd_arg *arg)
 }
 
 
+/* Whether a multi-turn command that is in progress can go on without asking
+   the client first.  Running and travel are left to the client, so that it
+   can show every step. */
+static boolean
+can_fast_forward(void)
+{
+    return occupation || multi < 0 || (multi > 0 && !flags.mv);
+}
+
+
+/* Perform one more step of a multi-turn command, like a client that sends an
+ * empty command to continue it would, but without the display updates of a
+ * single step: the status line and the periodic map updates wait until the
+ * end of the command or until a message is shown.  The replay of a continued
+ * command calls this with the argument of the command. */
+void
+continue_command(struct nh_cmd_arg *arg)
+{
+    fast_forwarding = TRUE;
+    command_input(-1, 0, arg);
+    fast_forwarding = FALSE;
+}
+
+
+/* A command was left via longjmp (e.g. the hero died during a step), so
+   continue_command() didn't get to clear the flag. */
+void
+fast_forward_unwind(void)
+{
+    fast_forwarding = FALSE;
+}
+
+
 /* command wrapper function: make sure the game is able to run commands, perform
  * logging and generate reasonable return values for api clients with no access
  * to internal state */
 int
 nh_command(const char *cmd, int rep, struct nh_cmd_arg *arg)
 {
-    int cmdidx, cmdresult;
+    int cmdidx, cmdresult, steps;
     unsigned int pre_rngstate, pre_moves;
 
     if (!program_state.game_running)
@@ -867,7 +948,8 @@ nh_command(const char *cmd, int rep, struct nh_cmd_arg *arg)
     }
 
     /* if the game is being restored, turntime is set in restore_read_command */
-    turntime = time(NULL);
+    if (!bench_fixed_seed(NULL, &turntime))
+        turntime = time(NULL);
     log_command(cmdidx, rep, arg);
 
     pre_rngstate = mt_nextstate();
@@ -876,12 +958,29 @@ nh_command(const char *cmd, int rep, struct nh_cmd_arg *arg)
     /* do the deed. command_input returns -1 if the command completed normally */
     cmdresult = command_input(cmdidx, rep, arg);
 
+    /* With the fast_forward option, a counted or multi-turn command goes on
+       here for a while instead of returning to the client after every step.
+       Only the number of steps is logged; the log_command_result() below
+       covers all of them. */
+    if (cmdresult == -1 && iflags.fast_forward) {
+        for (steps = 0; steps < iflags.fast_forward && can_fast_forward();
+             steps++) {
+            log_command_continued();
+            continue_command(arg);
+        }
+        if (steps && (multi || occupation))
+            flush_screen();     /* otherwise the last step did it */
+    }
+
     /* make sure we actually want this command to be logged */
     if (cmdidx >= 0 && (cmdlist[cmdidx].flags & CMD_NOTIME) &&
         pre_rngstate == mt_nextstate() && pre_moves == moves)
         log_revert_command();   /* nope, cut it out of the log */
-    else
+    else {
+        bench_start(BENCH_LOG_RESULT);
         log_command_result();   /* log the result */
+        bench_stop(BENCH_LOG_RESULT);
+    }
 
     api_exit(); /* no unsafe operations after this point */
 
@@ -908,6 +1007,7 @@ nh_command(const char *cmd, int rep, struct nh_cmd_arg *arg)
     else if (multi < 0)
         return POST_ACTION_DELAY;
 
+    pregen_after_command();
     return READY_FOR_INPUT;
 }
 
@@ -1930,7 +1930,7 @@ use_stone(struct obj *tstone)
     /* when the touchstone is fully known, don't bother listing extra junk as
        likely candidates for rubbing */
     choices = (tstone->otyp == TOUCHSTONE && tstone->dknown &&
-               objects[TOUCHSTONE].oc_name_known) ? justgems : allowall;
+               objstate[TOUCHSTONE].oc_name_known) ? justgems : allowall;
     sprintf(stonebuf, "rub on the stone%s", plur(tstone->quan));
     if ((obj = getobj(choices, stonebuf)) == 0)
         return 0;
@@ -1979,16 +1979,16 @@ use_stone(struct obj *tstone)
             return 1;
         } else {
             /* either a ring or the touchstone was not effective */
-            if (objects[obj->otyp].oc_material == GLASS) {
+            if (objstate[obj->otyp].oc_material == GLASS) {
                 do_scratch = TRUE;
                 break;
             }
         }
-        streak_color = c_obj_colors[objects[obj->otyp].oc_color];
+        streak_color = c_obj_colors[objstate[obj->otyp].oc_color];
         break;  /* gem or ring */
 
     default:
-        switch (objects[obj->otyp].oc_material) {
+        switch (objstate[obj->otyp].oc_material) {
         case CLOTH:
             pline("%s a little more polished now.", Tobjnam(tstone, "look"));
             return 1;
@@ -2017,7 +2017,7 @@ use_stone(struct obj *tstone)
                They will leave streaks on non-touchstones and touchstones
                alike. */
             if (is_flimsy(obj))
-                streak_color = c_obj_colors[objects[obj->otyp].oc_color];
+                streak_color = c_obj_colors[objstate[obj->otyp].oc_color];
             else
                 do_scratch = (tstone->otyp != TOUCHSTONE);
             break;
@@ -42,6 +42,15 @@ static boolean artiexist[1 + NROFARTIFACTS + 1];
 /* and a discovery list for them (no dummy first entry here) */
 static xchar artidisco[NROFARTIFACTS];
 
+/* the alignment and role of each artifact in this game; they start out as in
+   artilist[], which is shared by all games, and hack_artifacts() adjusts
+   some of them to the hero */
+static aligntyp artialign[1 + NROFARTIFACTS + 1];
+static short artirole[1 + NROFARTIFACTS + 1];
+
+#define arti_align(a)   artialign[(a) - artilist]
+#define arti_role(a)    artirole[(a) - artilist]
+
 static void hack_artifacts(void);
 static boolean attacks(int, struct obj *);
 
@@ -49,30 +58,34 @@ static boolean attacks(int, struct obj *);
 void
 init_artilist(void)
 {
-    artilist = malloc(sizeof (const_artilist));
-    memcpy(artilist, const_artilist, sizeof (const_artilist));
+    int i;
+
+    for (i = 0; i < SIZE(artilist); i++) {
+        artialign[i] = artilist[i].alignment;
+        artirole[i] = artilist[i].role;
+    }
 }
 
 /* handle some special cases; must be called after u_init() */
 static void
 hack_artifacts(void)
 {
-    struct artifact *art;
+    const struct artifact *art;
     int alignmnt = aligns[u.initalign].value;
 
     /* Fix up the alignments of "gift" artifacts */
     for (art = artilist + 1; art->otyp; art++)
-        if (art->role == Role_switch && art->alignment != A_NONE)
-            art->alignment = alignmnt;
+        if (arti_role(art) == Role_switch && arti_align(art) != A_NONE)
+            arti_align(art) = alignmnt;
 
     /* Excalibur can be used by any lawful character, not just knights */
     if (!Role_if(PM_KNIGHT))
-        artilist[ART_EXCALIBUR].role = NON_PM;
+        artirole[ART_EXCALIBUR] = NON_PM;
 
     /* Fix up the quest artifact */
     if (urole.questarti) {
-        artilist[urole.questarti].alignment = alignmnt;
-        artilist[urole.questarti].role = Role_switch;
+        artialign[urole.questarti] = alignmnt;
+        artirole[urole.questarti] = Role_switch;
     }
     return;
 }
@@ -136,12 +149,12 @@ struct obj *mk_artifact(struct obj *otmp,       /* existing object; ignored if
     /* gather eligible artifacts */
     for (n = 0, a = artilist + 1, m = 1; a->otyp; a++, m++)
         if ((!by_align ? a->otyp ==
-             o_typ : (a->alignment == alignment ||
-                      (a->alignment == A_NONE && u.ugifts > 0))) &&
+             o_typ : (arti_align(a) == alignment ||
+                      (arti_align(a) == A_NONE && u.ugifts > 0))) &&
             (!(a->spfx & SPFX_NOGEN) || unique) && !artiexist[m]) {
             if (by_align && a->race != NON_PM && race_hostile(&mons[a->race]))
                 continue;       /* skip enemies' equipment */
-            else if (by_align && Role_if(a->role))
+            else if (by_align && Role_if(arti_role(a)))
                 goto make_artif;        /* 'a' points to the desired one */
             else
                 eligible[n++] = m;
@@ -530,15 +543,15 @@ touch_artifact(struct obj *obj, struct monst *mon)
     self_willed = ((oart->spfx & SPFX_INTEL) != 0);
     if (yours) {
         badclass = self_willed &&
-            ((oart->role != NON_PM && !Role_if(oart->role)) ||
+            ((arti_role(oart) != NON_PM && !Role_if(arti_role(oart))) ||
              (oart->race != NON_PM && !Race_if(oart->race)));
-        badalign = (oart->spfx & SPFX_RESTR) && oart->alignment != A_NONE &&
-            (oart->alignment != u.ualign.type || u.ualign.record < 0);
+        badalign = (oart->spfx & SPFX_RESTR) && arti_align(oart) != A_NONE &&
+            (arti_align(oart) != u.ualign.type || u.ualign.record < 0);
     } else if (!is_covetous(mon->data) && !is_mplayer(mon->data)) {
-        badclass = self_willed && oart->role != NON_PM &&
+        badclass = self_willed && arti_role(oart) != NON_PM &&
             oart != &artilist[ART_EXCALIBUR];
-        badalign = (oart->spfx & SPFX_RESTR) && oart->alignment != A_NONE &&
-            (oart->alignment != sgn(mon->data->maligntyp));
+        badalign = (oart->spfx & SPFX_RESTR) && arti_align(oart) != A_NONE &&
+            (arti_align(oart) != sgn(mon->data->maligntyp));
     } else {    /* an M3_WANTSxxx monster or a fake player */
         /* special monsters trying to take the Amulet, invocation tools or
            quest item can touch anything except for `spec_applies' artifacts */
@@ -604,8 +617,9 @@ spec_applies(const struct artifact *weap, struct monst *mtmp)
                  ((!Upolyd && (urace.selfmask & weap->mtype)) ||
                   ((weap->mtype & M2_WERE) && u.ulycn >= LOW_PM))));
     } else if (weap->spfx & SPFX_DALIGN) {
-        return yours ? (u.ualign.type != weap->alignment) :
-          (ptr->maligntyp == A_NONE || sgn(ptr->maligntyp) != weap->alignment);
+        return yours ? (u.ualign.type != arti_align(weap)) :
+          (ptr->maligntyp == A_NONE ||
+           sgn(ptr->maligntyp) != arti_align(weap));
     } else if (weap->spfx & SPFX_ATTK) {
         struct obj *defending_weapon = (yours ? uwep : MON_WEP(mtmp));
 
@@ -729,7 +743,7 @@ disp_artifact_discoveries(struct menulist *menu /* supplied by dodiscover() */
         m = artidisco[i];
         otyp = artilist[m].otyp;
         sprintf(buf, "  %s [%s %s]", artiname(m),
-                align_str(artilist[m].alignment), simple_typename(otyp));
+                align_str(artialign[m]), simple_typename(otyp));
         add_menutext(menu, buf);
     }
     return i;
@@ -1335,8 +1349,8 @@ arti_invoke(struct obj *obj)
                     obj->age = 0;
                     return 0;
                 }
-                b_effect = obj->blessed && (Role_switch == oart->role ||
-                                            !oart->role);
+                b_effect = obj->blessed && (Role_switch == arti_role(oart) ||
+                                            !arti_role(oart));
                 recharge(otmp, b_effect ? 1 : obj->cursed ? -1 : 0);
                 update_inventory();
                 break;
@@ -0,0 +1,132 @@
+/* vim:set cin ft=c sw=4 sts=4 ts=8 et ai cino=Ls\:0t0(0 : -*- mode:c;fill-column:80;tab-width:8;c-basic-offset:4;indent-tabs-mode:nil;c-file-style:"k&r" -*-*/
+/* NetHack may be freely redistributed.  See license for details. */
+
+/* Hooks for the headless benchmark (nethack_bench): fixed game seeds and
+ * per-phase timing of the expensive parts of the game core, along with counts
+ * of a few events that show how much work those parts do.
+ *
+ * Timing is off unless a client calls nh_bench_enable(), so the only cost for
+ * normal games is a flag test per hook.  Phases nest (e.g. vision_recalc() is
+ * often called from inside movemon()), and each phase reports inclusive time;
+ * recursive entry into the same phase is only counted once. */
+
+#include "hack.h"
+
+#include <time.h>
+
+static boolean bench_enabled = FALSE;
+static boolean seed_fixed = FALSE;
+static unsigned int fixed_seed;
+static unsigned long long fixed_gametime;
+
+static struct nh_bench_stats bench_stats;
+static int phase_depth[BENCH_PHASE_COUNT];
+static unsigned long long phase_begin[BENCH_PHASE_COUNT];
+
+
+static unsigned long long
+bench_clock(void)
+{
+#if defined(UNIX)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+    return (unsigned long long)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+
+/* Make nh_start_game use the given seed and start time, and stop nh_command
+ * from following the wall clock, so that a scripted game is reproducible. */
+void
+nh_bench_fix_seed(boolean fixed, unsigned int seed,
+                  unsigned long long gametime)
+{
+    seed_fixed = fixed;
+    fixed_seed = seed;
+    fixed_gametime = gametime;
+}
+
+
+void
+nh_bench_enable(boolean enable)
+{
+    bench_enabled = enable;
+}
+
+
+void
+nh_bench_reset(void)
+{
+    memset(&bench_stats, 0, sizeof (bench_stats));
+    memset(phase_depth, 0, sizeof (phase_depth));
+}
+
+
+void
+nh_bench_get_stats(struct nh_bench_stats *stats)
+{
+    *stats = bench_stats;
+}
+
+
+/* returns TRUE and fills in the fixed values if nh_bench_fix_seed is active;
+ * either pointer may be NULL */
+boolean
+bench_fixed_seed(unsigned int *seed, unsigned long long *gametime)
+{
+    if (!seed_fixed)
+        return FALSE;
+
+    if (seed)
+        *seed = fixed_seed;
+    if (gametime)
+        *gametime = fixed_gametime;
+    return TRUE;
+}
+
+
+void
+bench_start(enum nh_bench_phase phase)
+{
+    if (!bench_enabled)
+        return;
+
+    if (phase_depth[phase]++ == 0)
+        phase_begin[phase] = bench_clock();
+}
+
+
+void
+bench_stop(enum nh_bench_phase phase)
+{
+    /* a phase that was entered before the benchmark was switched on */
+    if (!bench_enabled || phase_depth[phase] <= 0)
+        return;
+
+    if (--phase_depth[phase] == 0) {
+        bench_stats.calls[phase]++;
+        bench_stats.nsec[phase] += bench_clock() - phase_begin[phase];
+    }
+}
+
+
+/* A command was left via longjmp (e.g. the hero died or the game panicked in
+   the middle of it), so the phases that were running will never be stopped. */
+void
+bench_unwind(void)
+{
+    memset(phase_depth, 0, sizeof (phase_depth));
+}
+
+
+void
+bench_count(enum nh_bench_counter counter, int n)
+{
+    if (bench_enabled)
+        bench_stats.count[counter] += n;
+}
+
+/* bench.c */
@@ -391,6 +391,7 @@ getbones(d_level * levnum)
 
         if (fd == -1)
             return 0;
+        pregen_worker_abort();  /* only the real game may use up bones */
         mf.buf = loadfile(fd, &mf.len);
         close(fd);
         if (!mf.buf)
@@ -0,0 +1,295 @@
+/* vim:set cin ft=c sw=4 sts=4 ts=8 et ai cino=Ls\:0t0(0 : -*- mode:c;fill-column:80;tab-width:8;c-basic-offset:4;indent-tabs-mode:nil;c-file-style:"k&r" -*-*/
+/* NetHack may be freely redistributed.  See license for details. */
+
+/* Compressed storage for levels the hero hasn't been on for a while (the
+ * "cold_levels" option).
+ *
+ * Normally every visited level stays in memory for the rest of the game.  If
+ * the option is set to N, then at the end of each command every level that
+ * the hero left at least N turns ago is written with savelev(), compressed,
+ * and freed.  level_by_ledger() brings such a level back with getlev() as
+ * soon as anything needs it.  The result is exactly the level a save and restore of
+ * the whole game would produce.
+ *
+ * Cold levels are still part of every save, and the saves (and therefore the
+ * diffs in the log) must not change.  So along with the data, the positions
+ * of the memfile tags that savelev() placed are kept, and save_cold_level()
+ * copies the data into the save piece by piece, placing the same tags in
+ * between.  The one thing savelev() writes that doesn't belong to the level
+ * is the current turn, as the timestamp of the region data; it is patched to
+ * the turn of the save or of the restore, so that region timeouts don't see
+ * the time the level spent in cold storage.
+ *
+ * Levels with shop damage are never frozen, because restoring them may let
+ * the shopkeeper repair the damage.
+ *
+ * Nothing can change a level while it is cold, so what the dungeon overview
+ * shows about it is worked out when it is frozen and kept with the data.
+ */
+
+#include "hack.h"
+#include <zlib.h>
+
+/* mfalign() writes padding when a memfile position is below 4, even while
+   reading.  The level data is kept after this many unused bytes in the
+   memfiles used here, like it never is at the start of a real save. */
+#define COLD_PREFIX 4
+
+struct cold_tag {
+    int pos;
+    long tagdata;
+    enum memfile_tagtype tagtype;
+};
+
+struct cold_level {
+    unsigned char *data;        /* compressed output of savelev() */
+    unsigned long datalen;
+    unsigned long rawlen;
+    int region_pos;     /* where the timestamp of the region data is */
+    int ntags;
+    struct cold_tag *tags;      /* in the order of their positions */
+    struct overview_info oinfo; /* overview_scan() at the time of freezing */
+};
+
+static struct cold_level *cold_levels[MAXLINFO];
+
+
+static int
+cold_tag_cmp(const void *a, const void *b)
+{
+    return ((const struct cold_tag *)a)->pos -
+        ((const struct cold_tag *)b)->pos;
+}
+
+
+static void
+put_le32(unsigned char *buf, unsigned int value)
+{
+    buf[0] = value & 0xff;
+    buf[1] = (value >> 8) & 0xff;
+    buf[2] = (value >> 16) & 0xff;
+    buf[3] = (value >> 24) & 0xff;
+}
+
+
+/* Decompress a level's data into buf + offset and set its region timestamp
+   to the current turn. */
+static void
+unpack_cold_level(const struct cold_level *cl, unsigned char *buf, int offset)
+{
+    unsigned long rawlen = cl->rawlen;
+
+    if (uncompress(buf + offset, &rawlen, cl->data, cl->datalen) != Z_OK ||
+        rawlen != cl->rawlen)
+        panic("Could not decompress cold level data!");
+    put_le32(buf + offset + cl->region_pos, moves);
+}
+
+
+static void
+free_cold_level(xchar ledger)
+{
+    struct cold_level *cl = cold_levels[ledger];
+
+    cold_levels[ledger] = NULL;
+    if (!cl)
+        return;
+    free(cl->data);
+    free(cl->tags);
+    free(cl);
+}
+
+
+static void
+freeze_level(xchar ledger)
+{
+    struct level *lev = levels[ledger];
+    struct cold_level *cl;
+    struct memfile mf;
+    struct memfile_tag *tag;
+    struct monst *mtmp;
+    struct obj *otmp;
+    int i, n;
+
+    mnew(&mf, NULL);
+    mwrite32(&mf, 0);   /* COLD_PREFIX */
+    savelev(&mf, ledger);
+
+    cl = malloc(sizeof (struct cold_level));
+    cl->rawlen = mf.pos - COLD_PREFIX;
+    cl->datalen = compressBound(cl->rawlen);
+    cl->data = malloc(cl->datalen);
+    if (compress2(cl->data, &cl->datalen,
+                  (unsigned char *)mf.buf + COLD_PREFIX, cl->rawlen,
+                  Z_BEST_SPEED) != Z_OK)
+        panic("Could not compress cold level data!");
+    cl->data = realloc(cl->data, cl->datalen);
+
+    n = 0;
+    for (i = 0; i < MEMFILE_HASHTABLE_SIZE; i++)
+        for (tag = mf.tags[i]; tag; tag = tag->next)
+            n++;
+    cl->ntags = n;
+    cl->tags = malloc(n * sizeof (struct cold_tag));
+    cl->region_pos = -1;
+
+    n = 0;
+    for (i = 0; i < MEMFILE_HASHTABLE_SIZE; i++)
+        for (tag = mf.tags[i]; tag; tag = tag->next) {
+            cl->tags[n].pos = tag->pos - COLD_PREFIX;
+            cl->tags[n].tagdata = tag->tagdata;
+            cl->tags[n].tagtype = tag->tagtype;
+            /* save_regions() writes the timestamp right after the magic
+               number that follows its tag */
+            if (tag->tagtype == MTAG_REGION)
+                cl->region_pos = cl->tags[n].pos + 4;
+            n++;
+        }
+    /* savelev() writes data after each tag, so no two tags share a position
+       and sorting by position restores the order they were placed in */
+    qsort(cl->tags, cl->ntags, sizeof (struct cold_tag), cold_tag_cmp);
+    mfree(&mf);
+
+    if (cl->region_pos < 0)
+        panic("freeze_level: no region data on level %d", ledger);
+
+    overview_scan(lev, &cl->oinfo);
+
+    /* Monsters that left the level for another one still point to it.  A
+       restore would make them point to the current level instead. */
+    for (mtmp = migrating_mons; mtmp; mtmp = mtmp->nmon)
+        if (mtmp->dlevel == lev) {
+            mtmp->dlevel = level;
+            for (otmp = mtmp->minvent; otmp; otmp = otmp->nobj)
+                set_obj_level(level, otmp);
+        }
+
+    freelev(ledger);
+    cold_levels[ledger] = cl;
+}
+
+
+static void
+thaw_level(xchar ledger)
+{
+    struct cold_level *cl = cold_levels[ledger];
+    struct level *curlev = level;
+    struct memfile mf;
+
+    mnew(&mf, NULL);
+    mf.len = cl->rawlen + COLD_PREFIX;
+    mf.buf = malloc(mf.len);
+    memset(mf.buf, 0, COLD_PREFIX);
+    unpack_cold_level(cl, (unsigned char *)mf.buf, COLD_PREFIX);
+    mf.pos = COLD_PREFIX;
+    free_cold_level(ledger);
+
+    level = NULL;       /* level restore must not use this pointer */
+    getlev(&mf, ledger, FALSE);
+    level = curlev;
+
+    mfree(&mf);
+}
+
+
+/* Returns the level with the given ledger number, restoring it from cold
+   storage if necessary, or NULL if it hasn't been made yet. */
+struct level *
+level_by_ledger(xchar ledger)
+{
+    if (!levels[ledger] && cold_levels[ledger])
+        thaw_level(ledger);
+    return levels[ledger];
+}
+
+
+/* Like level_by_ledger() != NULL, but leaves a cold level where it is. */
+boolean
+level_exists(xchar ledger)
+{
+    return levels[ledger] || cold_levels[ledger];
+}
+
+
+boolean
+level_is_cold(xchar ledger)
+{
+    return cold_levels[ledger] != NULL;
+}
+
+
+/* Fills in *oi like overview_scan() for a level that exists, without
+   restoring it from cold storage.  Returns FALSE if it hasn't been made. */
+boolean
+level_overview(xchar ledger, struct overview_info *oi)
+{
+    if (levels[ledger])
+        overview_scan(levels[ledger], oi);
+    else if (cold_levels[ledger])
+        *oi = cold_levels[ledger]->oinfo;
+    else
+        return FALSE;
+
+    /* branches and portals only count once their other end exists, which
+       may have happened after the scan */
+    if (oi->branch && !level_exists(ledger_no(&oi->branch_dst)))
+        oi->branch = FALSE;
+    if (oi->portal && !level_exists(ledger_no(&oi->portal_dst)))
+        oi->portal = FALSE;
+    return TRUE;
+}
+
+
+/* Called once per command. */
+void
+freeze_idle_levels(void)
+{
+    xchar ledger;
+    struct level *lev;
+
+    if (!iflags.cold_levels || !level || mydogs)
+        return;
+
+    for (ledger = 1; ledger <= maxledgerno(); ledger++) {
+        lev = levels[ledger];
+        if (!lev || lev == level || lev->damagelist)
+            continue;
+        if ((int)moves - lev->lastmoves < iflags.cold_levels)
+            continue;
+        freeze_level(ledger);
+    }
+}
+
+
+/* Write a cold level to a save exactly like savelev() would. */
+void
+save_cold_level(struct memfile *mf, xchar ledger)
+{
+    const struct cold_level *cl = cold_levels[ledger];
+    unsigned char *buf = malloc(cl->rawlen);
+    int i, pos;
+
+    unpack_cold_level(cl, buf, 0);
+
+    pos = 0;
+    for (i = 0; i < cl->ntags; i++) {
+        mwrite(mf, buf + pos, cl->tags[i].pos - pos);
+        pos = cl->tags[i].pos;
+        mtag(mf, cl->tags[i].tagdata, cl->tags[i].tagtype);
+    }
+    mwrite(mf, buf + pos, cl->rawlen - pos);
+
+    free(buf);
+}
+
+
+void
+free_cold_levels(void)
+{
+    int i;
+
+    for (i = 0; i < MAXLINFO; i++)
+        free_cold_level(i);
+}
+
+/* coldlev.c */
@@ -188,7 +188,6 @@ struct permonst pm_you_male, pm_you_female;
 int exit_jmp_buf_valid;
 nh_jmp_buf exit_jmp_buf;
 
-struct artifact *artilist;
 short disco[NUM_OBJECTS];       /* discovered objects */
 
 unsigned int histcount;
@@ -262,7 +261,6 @@ init_data(void)
     migrating_mons = mydogs = NULL;
     vision_full_recalc = FALSE;
     viz_array = NULL;
-    artilist = NULL;
     stetho_last_used_movement = 0;
     stetho_last_used_move = -1;
     branch_id = 0;
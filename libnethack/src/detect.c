@@ -48,12 +48,12 @@ o_material(struct obj *obj, unsigned material)
     struct obj *otmp;
     struct obj *temp;
 
-    if (objects[obj->otyp].oc_material == material)
+    if (objstate[obj->otyp].oc_material == material)
         return obj;
 
     if (Has_contents(obj)) {
         for (otmp = obj->cobj; otmp; otmp = otmp->nobj)
-            if (objects[otmp->otyp].oc_material == material)
+            if (objstate[otmp->otyp].oc_material == material)
                 return otmp;
             else if (Has_contents(otmp) && (temp = o_material(otmp, material)))
                 return temp;
@@ -88,7 +88,7 @@ check_map_spot(int x, int y, char oclass, unsigned material)
             return (!(level->objects[x][y] ||   /* stale if nothing here */
                       ((mtmp = m_at(level, x, y)) != 0 && mtmp->minvent)));
         } else {
-            if (material && objects[memobj - 1].oc_material == material) {
+            if (material && objstate[memobj - 1].oc_material == material) {
                 /* the object shown here is of interest because material
                    matches */
                 for (otmp = level->objects[x][y]; otmp; otmp = otmp->nexthere)
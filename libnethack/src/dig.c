@@ -886,7 +886,7 @@ use_pick_axe2(struct obj *obj, schar dx, schar dy, schar dz)
         if (dam <= 0)
             dam = 1;
         pline("You hit yourself with %s.", yname(uwep));
-        sprintf(buf, "%s own %s", uhis(), OBJ_NAME(objects[obj->otyp]));
+        sprintf(buf, "%s own %s", uhis(), OBJ_NAME(obj->otyp));
         losehp(dam, buf, KILLED_BY);
         iflags.botl = 1;
         return 1;
@@ -1382,7 +1382,7 @@ obfuscate_object(int otyp)
     /* object ids are shifted by 1 for display, so that 0 can mean "no object" */
     otyp -= 1;
 
-    if (!objects[otyp].oc_name_known) {
+    if (!objstate[otyp].oc_name_known) {
         switch (otyp) {
         case SACK:
         case OILSKIN_SACK:
@@ -1431,7 +1431,7 @@ obfuscate_object(int otyp)
         case OBSIDIAN:
         case AGATE:
         case JADE:
-            switch (objects[otyp].oc_color) {
+            switch (objstate[otyp].oc_color) {
             case CLR_WHITE:
                 otyp = WORTHLESS_PIECE_OF_WHITE_GLASS;
                 break;
@@ -1465,7 +1465,7 @@ obfuscate_object(int otyp)
     }
 
     /* finally, account for shuffled descriptions */
-    return objects[otyp].oc_descr_idx + 1;
+    return objstate[otyp].oc_descr_idx + 1;
 }
 
 
@@ -1597,10 +1597,12 @@ flush_screen(void)
     if (delay_flushing)
         return;
 
+    bench_start(BENCH_FLUSH_SCREEN);
     update_screen(dbuf, u.ux, u.uy);
 
     if (iflags.botl)
         bot();
+    bench_stop(BENCH_FLUSH_SCREEN);
 }
 
 
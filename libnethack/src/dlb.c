@@ -6,6 +6,14 @@
 #include "config.h"
 #include "dlb.h"
 
+#include <ctype.h>
+
+#if defined(UNIX)
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+#endif
+
 /* without extern.h via hack.h, these haven't been declared for us */
 extern FILE *fopen_datafile(const char *, const char *, int);
 
@@ -42,6 +50,9 @@ typedef struct dlb_procs {
  * only in the Amiga port (the second library holds the sound files).
  * For Unix, the idea would be to split the NetHack library
  * into text and binary parts, where the text version could be shared.
+ *
+ * File names are looked up via a hash of the directory, since some callers
+ * (help lookups, rumors, special levels) reopen their files very often.
  */
 
 #define MAX_LIBS 4
@@ -104,6 +115,36 @@ extern char *eos(char *);
 #define DLB_MIN_VERS  1 /* min library version readable by this code */
 #define DLB_MAX_VERS  1 /* max library version readable by this code */
 
+static unsigned int
+hash_name(const char *name)
+{
+    unsigned int h = 2166136261U;
+
+    for (; *name; name++)
+        h = (h ^ FILENAME_FOLD((unsigned char)*name)) * 16777619U;
+    return h;
+}
+
+/* Build the open-addressed name -> directory index table. */
+static void
+hash_libdir(library * lp)
+{
+    int i, h;
+
+    for (lp->hashsize = 16; lp->hashsize < 2 * lp->nentries;)
+        lp->hashsize *= 2;
+    lp->hash = malloc(lp->hashsize * sizeof (int));
+    for (i = 0; i < lp->hashsize; i++)
+        lp->hash[i] = -1;
+
+    for (i = 0; i < lp->nentries; i++) {
+        h = hash_name(lp->dir[i].fname) & (lp->hashsize - 1);
+        while (lp->hash[h] != -1)
+            h = (h + 1) & (lp->hashsize - 1);
+        lp->hash[h] = i;
+    }
+}
+
 /*
  * Read the directory from the library file.   This will allocate and
  * fill in our globals.  The file pointer is reset back to position
@@ -152,6 +193,8 @@ readlibdir(library * lp)
             lp->dir[i].fsize = lp->dir[i + 1].foffset - lp->dir[i].foffset;
     }
 
+    hash_libdir(lp);
+
     fseek(lp->fdata, 0L, SEEK_SET);     /* reset back to zero */
     lp->fmark = 0;
 
@@ -165,12 +208,14 @@ readlibdir(library * lp)
 static boolean
 find_file(const char *name, library ** lib, long *startp, long *sizep)
 {
-    int i, j;
+    int i, j, h;
+    unsigned int namehash = hash_name(name);
     library *lp;
 
     for (i = 0; i < MAX_LIBS && dlb_libs[i].fdata; i++) {
         lp = &dlb_libs[i];
-        for (j = 0; j < lp->nentries; j++) {
+        for (h = namehash & (lp->hashsize - 1); (j = lp->hash[h]) != -1;
+             h = (h + 1) & (lp->hashsize - 1)) {
             if (FILENAME_CMP(name, lp->dir[j].fname) == 0) {
                 *lib = lp;
                 *startp = lp->dir[j].foffset;
@@ -208,9 +253,14 @@ open_library(const char *lib_name, library * lp)
 void
 close_library(library * lp)
 {
+#if defined(UNIX)
+    if (lp->mapped)
+        munmap((void *)lp->mapped, lp->mapsize);
+#endif
     fclose(lp->fdata);
     free(lp->dir);
     free(lp->sspace);
+    free(lp->hash);
 
     memset((char *)lp, 0, sizeof (library));
 }
@@ -384,6 +434,146 @@ const dlb_procs_t lib_dlb_procs = {
     lib_dlb_ftell
 };
 
+
+/*
+ * Reading from memory: used by the mapped library implementation below and
+ * for files preloaded with dlb_preload().  Seeking and telling only involve
+ * the handle's mark, so the stdio implementation's functions work for both.
+ */
+
+static const char *
+mem_dlb_data(dlb * dp)
+{
+    return dp->mem ? dp->mem : dp->lib->mapped + dp->start;
+}
+
+/* the mapping may be shorter than the directory claims if the library is
+   truncated; treat that as EOF rather than reading past the end */
+static long
+mem_dlb_avail(dlb * dp)
+{
+    long end = dp->mem ? dp->size : dp->lib->mapsize - dp->start;
+
+    if (end > dp->size)
+        end = dp->size;
+    return end > dp->mark ? end - dp->mark : 0;
+}
+
+static int
+mem_dlb_fread(char *buf, int size, int quan, dlb * dp)
+{
+    long avail = mem_dlb_avail(dp);
+
+    if (avail < (long)size * quan)
+        quan = avail / size;
+    if (quan == 0)
+        return 0;
+
+    memcpy(buf, mem_dlb_data(dp) + dp->mark, (long)size * quan);
+    dp->mark += (long)size * quan;
+    return quan;
+}
+
+static char *
+mem_dlb_fgets(char *buf, int len, dlb * dp)
+{
+    long avail = mem_dlb_avail(dp);
+    const char *src, *nl;
+
+    if (len <= 0)
+        return buf;     /* sanity check */
+
+    /* return NULL on EOF */
+    if (avail == 0)
+        return NULL;
+
+    len--;      /* save room for null */
+    if (avail > len)
+        avail = len;
+    src = mem_dlb_data(dp) + dp->mark;
+    if ((nl = memchr(src, '\n', avail)) != 0)
+        avail = nl - src + 1;
+
+    memcpy(buf, src, avail);
+    buf[avail] = '\0';
+    dp->mark += avail;
+
+#if defined(WIN32)
+    {
+        char *bp;
+
+        if ((bp = strchr(buf, '\r')) != 0) {
+            *bp++ = '\n';
+            *bp = '\0';
+        }
+    }
+#endif
+
+    return buf;
+}
+
+static int
+mem_dlb_fgetc(dlb * dp)
+{
+    if (mem_dlb_avail(dp) == 0)
+        return EOF;
+    return (int)mem_dlb_data(dp)[dp->mark++];
+}
+
+
+#if defined(UNIX)
+/*
+ * Mapped Library Implementation:
+ *
+ * The libraries are opened as above, then each one is mapped read-only in
+ * its entirety.  Reads become copies out of the mapping, so opening and
+ * reading a file inside the library costs no system calls at all, and all
+ * processes (e.g. the forked children of the server) share the same pages
+ * of the page cache.
+ *
+ * Opening, seeking and closing are shared with the stdio implementation;
+ * only the handle's mark is used, never the library's FILE.
+ */
+
+static boolean
+mmap_dlb_init(void)
+{
+    int i;
+    struct stat st;
+    void *map;
+
+    if (!lib_dlb_init())
+        return FALSE;
+
+    for (i = 0; i < MAX_LIBS && dlb_libs[i].fdata; i++) {
+        map = MAP_FAILED;
+        if (fstat(fileno(dlb_libs[i].fdata), &st) == 0 && st.st_size > 0)
+            map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED,
+                       fileno(dlb_libs[i].fdata), 0);
+        if (map == MAP_FAILED) {
+            /* let dlb_init() fall back to stdio */
+            lib_dlb_cleanup();
+            return FALSE;
+        }
+        dlb_libs[i].mapped = map;
+        dlb_libs[i].mapsize = st.st_size;
+    }
+    return TRUE;
+}
+
+const dlb_procs_t mmap_dlb_procs = {
+    mmap_dlb_init,
+    lib_dlb_cleanup,
+    lib_dlb_fopen,
+    lib_dlb_fclose,
+    mem_dlb_fread,
+    lib_dlb_fseek,
+    mem_dlb_fgets,
+    mem_dlb_fgetc,
+    lib_dlb_ftell
+};
+#endif
+
 /* Global wrapper functions ------------------------------------------------ */
 
 #define do_dlb_init (*dlb_procs->dlb_init_proc)
@@ -399,10 +589,95 @@ const dlb_procs_t lib_dlb_procs = {
 static const dlb_procs_t *dlb_procs;
 static boolean dlb_initialized = FALSE;
 
+/*
+ * Preloaded files:
+ *
+ * dlb_preload() reads a whole file into memory once; from then on dlb_fopen()
+ * of that name returns a handle reading from the copy, whether or not the
+ * libraries are open.  The copies are never modified, so a process that
+ * preloads before forking shares them with all its children.
+ */
+struct dlb_preloaded {
+    struct dlb_preloaded *next;
+    char *name;
+    char *data;
+    long size;
+};
+
+static struct dlb_preloaded *preloaded;
+
+static struct dlb_preloaded *
+find_preloaded(const char *name)
+{
+    struct dlb_preloaded *pl;
+
+    for (pl = preloaded; pl; pl = pl->next)
+        if (!FILENAME_CMP(pl->name, name))
+            return pl;
+    return NULL;
+}
+
+/* Read the named file into memory; the libraries must be open.  Returns
+   FALSE if the file doesn't exist. */
+boolean
+dlb_preload(const char *name)
+{
+    struct dlb_preloaded *pl;
+    dlb *dp;
+    char *data;
+    long size, len;
+    int n;
+
+    if (find_preloaded(name))
+        return TRUE;
+    if (!(dp = dlb_fopen(name, RDBMODE)))
+        return FALSE;
+
+    /* external files can't be trusted to report their size up front */
+    size = 0;
+    len = 8192;
+    data = malloc(len);
+    while ((n = dlb_fread(data + size, 1, len - size, dp)) > 0) {
+        size += n;
+        if (size == len) {
+            len *= 2;
+            data = realloc(data, len);
+        }
+    }
+    dlb_fclose(dp);
+
+    pl = malloc(sizeof (struct dlb_preloaded));
+    pl->name = strdup(name);
+    pl->data = realloc(data, size ? size : 1);
+    pl->size = size;
+    pl->next = preloaded;
+    preloaded = pl;
+    return TRUE;
+}
+
+void
+dlb_free_preloaded(void)
+{
+    struct dlb_preloaded *pl;
+
+    while ((pl = preloaded)) {
+        preloaded = pl->next;
+        free(pl->name);
+        free(pl->data);
+        free(pl);
+    }
+}
+
 boolean
 dlb_init(void)
 {
     if (!dlb_initialized) {
+#if defined(UNIX)
+        dlb_procs = &mmap_dlb_procs;
+        dlb_initialized = do_dlb_init();
+        if (dlb_initialized)
+            return TRUE;
+#endif
         dlb_procs = &lib_dlb_procs;
         if (dlb_procs)
             dlb_initialized = do_dlb_init();
@@ -425,11 +700,24 @@ dlb_fopen(const char *name, const char *mode)
 {
     FILE *fp;
     dlb *dp;
+    struct dlb_preloaded *pl;
+
+    if ((pl = find_preloaded(name)) != 0) {
+        dp = malloc(sizeof (dlb));
+        dp->fp = NULL;
+        dp->lib = NULL;
+        dp->mem = pl->data;
+        dp->start = 0;
+        dp->size = pl->size;
+        dp->mark = 0;
+        return dp;
+    }
 
     if (!dlb_initialized)
         return NULL;
 
     dp = malloc(sizeof (dlb));
+    dp->mem = NULL;
     if (do_dlb_fopen(dp, name, mode))
         dp->fp = NULL;
     else if ((fp = fopen_datafile(name, mode, DATAPREFIX)) != 0)
@@ -448,7 +736,9 @@ dlb_fclose(dlb * dp)
 {
     int ret = 0;
 
-    if (dlb_initialized) {
+    if (dp->mem)
+        free(dp);
+    else if (dlb_initialized) {
         if (dp->fp)
             ret = fclose(dp->fp);
         else
@@ -462,7 +752,11 @@ dlb_fclose(dlb * dp)
 int
 dlb_fread(void *buf, int size, int quan, dlb * dp)
 {
-    if (!dlb_initialized || size <= 0 || quan <= 0)
+    if (size <= 0 || quan <= 0)
+        return 0;
+    if (dp->mem)
+        return mem_dlb_fread(buf, size, quan, dp);
+    if (!dlb_initialized)
         return 0;
     if (dp->fp)
         return fread(buf, size, quan, dp->fp);
@@ -472,6 +766,8 @@ dlb_fread(void *buf, int size, int quan, dlb * dp)
 int
 dlb_fseek(dlb * dp, long pos, int whence)
 {
+    if (dp->mem)
+        return lib_dlb_fseek(dp, pos, whence);
     if (!dlb_initialized)
         return EOF;
     if (dp->fp)
@@ -482,6 +778,8 @@ dlb_fseek(dlb * dp, long pos, int whence)
 char *
 dlb_fgets(void *buf, int len, dlb * dp)
 {
+    if (dp->mem)
+        return mem_dlb_fgets(buf, len, dp);
     if (!dlb_initialized)
         return NULL;
     if (dp->fp)
@@ -492,6 +790,8 @@ dlb_fgets(void *buf, int len, dlb * dp)
 int
 dlb_fgetc(dlb * dp)
 {
+    if (dp->mem)
+        return mem_dlb_fgetc(dp);
     if (!dlb_initialized)
         return EOF;
     if (dp->fp)
@@ -502,6 +802,8 @@ dlb_fgetc(dlb * dp)
 long
 dlb_ftell(dlb * dp)
 {
+    if (dp->mem)
+        return lib_dlb_ftell(dp);
     if (!dlb_initialized)
         return 0;
     if (dp->fp)
@@ -268,7 +268,7 @@ doaltarobj(struct obj *obj)
 static void
 trycall(struct obj *obj)
 {
-    if (!objects[obj->otyp].oc_name_known && !objects[obj->otyp].oc_uname)
+    if (!objstate[obj->otyp].oc_name_known && !objstate[obj->otyp].oc_uname)
         docall(obj);
 }
 
@@ -1000,10 +1000,12 @@ goto_level(d_level * newlevel, boolean at_stairs, boolean falling,
     origlev = level;
     level = NULL;
 
-    if (!levels[new_ledger]) {
+    if (!level_by_ledger(new_ledger)) {
         /* entering this level for first time; make it now */
         historic_event(FALSE, "reached %s.", hist_lev_name(&u.uz, FALSE));
-        level = mklev(&u.uz);
+        level = pregen_take_level(&u.uz);
+        if (!level)
+            level = mklev(&u.uz);
         new = TRUE;     /* made the level */
     } else {
         /* returning to previously visited level */
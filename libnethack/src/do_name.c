@@ -284,7 +284,7 @@ docall_inner(int otyp)
         return;
 
     /* clear old name */
-    str1 = &(objects[otyp].oc_uname);
+    str1 = &(objstate[otyp].oc_uname);
     if (*str1)
         free(*str1);
 
@@ -392,7 +392,7 @@ do_naming(void)
                 continue;
             for (n = bases[(int)*s];
                  n < NUM_OBJECTS && objects[n].oc_class == *s; n++) {
-                if (!objects[n].oc_name_known && !objects[n].oc_unique &&
+                if (!objstate[n].oc_name_known && !objects[n].oc_unique &&
                     n != FAKE_AMULET_OF_YENDOR) {
                     if (*s != ARMOR_CLASS ||
                         (n >= HELMET && n <= HELM_OF_TELEPATHY) ||
@@ -405,8 +405,8 @@ do_naming(void)
             for (n = 0; n < aop; n++) {
                 for (i = n + 1; i < aop; i++) {
                     if (strcmp
-                        (OBJ_DESCR(objects[alphaorder[i]]),
-                         OBJ_DESCR(objects[alphaorder[n]])) < 0) {
+                        (OBJ_DESCR(alphaorder[i]),
+                         OBJ_DESCR(alphaorder[n])) < 0) {
                         int t = alphaorder[i];
 
                         alphaorder[i] = alphaorder[n];
@@ -451,7 +451,7 @@ docall(struct obj *obj)
         /* kludge, meaning it's sink water */
         sprintf(buf,
                 "(You can name a stream of %s fluid from the item naming menu.)",
-                OBJ_DESCR(objects[otemp.otyp]));
+                OBJ_DESCR(otemp.otyp));
     else
         sprintf(buf, "(You can name %s from the item naming menu.)",
                 an(xname(&otemp)));
@@ -563,8 +563,8 @@ Amulet_on(void)
                 pline("You don't feel like yourself.");
             pline("The amulet disintegrates!");
             if (orig_sex == poly_gender() && uamul->dknown &&
-                !objects[AMULET_OF_CHANGE].oc_name_known &&
-                !objects[AMULET_OF_CHANGE].oc_uname)
+                !objstate[AMULET_OF_CHANGE].oc_name_known &&
+                !objstate[AMULET_OF_CHANGE].oc_uname)
                 docall(uamul);
             useup(uamul);
             break;
@@ -737,7 +737,7 @@ Ring_on(struct obj *obj)
         old_attrib = ACURR(which);
         ABON(which) += obj->spe;
         if (ACURR(which) != old_attrib ||
-            (objects[obj->otyp].oc_name_known && old_attrib != 25 &&
+            (objstate[obj->otyp].oc_name_known && old_attrib != 25 &&
              old_attrib != 3)) {
             iflags.botl = 1;
             makeknown(obj->otyp);
@@ -755,7 +755,7 @@ Ring_on(struct obj *obj)
         resistcham();
         break;
     case RIN_PROTECTION:
-        if (obj->spe || objects[RIN_PROTECTION].oc_name_known) {
+        if (obj->spe || objstate[RIN_PROTECTION].oc_name_known) {
             iflags.botl = 1;
             makeknown(RIN_PROTECTION);
             obj->known = 1;
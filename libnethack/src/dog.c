@@ -726,7 +726,8 @@ dogfood(struct monst *mon, struct obj *obj)
         if (obj->otyp == AMULET_OF_STRANGULATION ||
             obj->otyp == RIN_SLOW_DIGESTION)
             return TABU;
-        if (hates_silver(mon->data) && objects[obj->otyp].oc_material == SILVER)
+        if (hates_silver(mon->data) &&
+            objstate[obj->otyp].oc_material == SILVER)
             return TABU;
         if (mon->data == &mons[PM_GELATINOUS_CUBE] && is_organic(obj))
             return ACCFOOD;
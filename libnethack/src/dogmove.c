@@ -520,7 +520,8 @@ dog_goal(struct monst *mtmp, struct edog *edog, int after, int udist,
 #define DDIST(x,y) (dist2(x,y,omx,omy))
 #define SQSRCHRADIUS 5
         int min_x, max_x, min_y, max_y;
-        int nx, ny;
+        int nx, ny, i, nobjs;
+        struct obj **objs;
         boolean can_use = FALSE;
 
         gtyp = UNDEF;   /* no goal as yet */
@@ -536,42 +537,43 @@ dog_goal(struct monst *mtmp, struct edog *edog, int after, int udist,
             max_y = ROWNO - 1;
 
         /* nearby food is the first choice, then other objects */
-        for (obj = level->objlist; obj; obj = obj->nobj) {
+        nobjs = floor_objects_in_box(level, min_x, min_y, max_x, max_y, &objs);
+        for (i = 0; i < nobjs; i++) {
+            obj = objs[i];
             nx = obj->ox;
             ny = obj->oy;
-            if (nx >= min_x && nx <= max_x && ny >= min_y && ny <= max_y) {
-                otyp = dogfood(mtmp, obj);
-                /* skip inferior goals */
-                if (otyp > gtyp || otyp == UNDEF)
-                    continue;
-                /* avoid cursed items unless starving */
-                if (cursed_object_at(nx, ny) &&
-                    !(edog->mhpmax_penalty && otyp < MANFOOD))
-                    continue;
-                /* skip completely unreacheable goals */
-                if (!could_reach_item(mtmp, nx, ny) ||
-                    !can_reach_location(mtmp, mtmp->mx, mtmp->my, nx, ny))
-                    continue;
-                if (otyp < MANFOOD) {
-                    if (otyp < gtyp || DDIST(nx, ny) < DDIST(gx, gy)) {
-                        gx = nx;
-                        gy = ny;
-                        gtyp = otyp;
-                    }
-                } else if (gtyp == UNDEF && in_masters_sight &&
-                           ((can_use = could_use_item(mtmp, obj)) &&
-                            !dog_has_minvent) &&
-                           (!level->locations[omx][omy].lit ||
-                            level->locations[u.ux][u.uy].lit) &&
-                           (otyp == MANFOOD || m_cansee(mtmp, nx, ny)) &&
-                           (can_use || edog->apport > rn2(8)) &&
-                           can_carry(mtmp, obj)) {
+            otyp = dogfood(mtmp, obj);
+            /* skip inferior goals */
+            if (otyp > gtyp || otyp == UNDEF)
+                continue;
+            /* avoid cursed items unless starving */
+            if (cursed_object_at(nx, ny) &&
+                !(edog->mhpmax_penalty && otyp < MANFOOD))
+                continue;
+            /* skip completely unreacheable goals */
+            if (!could_reach_item(mtmp, nx, ny) ||
+                !can_reach_location(mtmp, mtmp->mx, mtmp->my, nx, ny))
+                continue;
+            if (otyp < MANFOOD) {
+                if (otyp < gtyp || DDIST(nx, ny) < DDIST(gx, gy)) {
                     gx = nx;
                     gy = ny;
-                    gtyp = APPORT;
+                    gtyp = otyp;
                 }
+            } else if (gtyp == UNDEF && in_masters_sight &&
+                       ((can_use = could_use_item(mtmp, obj)) &&
+                        !dog_has_minvent) &&
+                       (!level->locations[omx][omy].lit ||
+                        level->locations[u.ux][u.uy].lit) &&
+                       (otyp == MANFOOD || m_cansee(mtmp, nx, ny)) &&
+                       (can_use || edog->apport > rn2(8)) &&
+                       can_carry(mtmp, obj)) {
+                gx = nx;
+                gy = ny;
+                gtyp = APPORT;
             }
         }
+        free(objs);
     }
 
     /* follow player if appropriate */
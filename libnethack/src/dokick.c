@@ -367,7 +367,7 @@ container_impact_dmg(struct obj *obj)
         const char *result = NULL;
 
         otmp2 = otmp->nobj;
-        if (objects[otmp->otyp].oc_material == GLASS &&
+        if (objstate[otmp->otyp].oc_material == GLASS &&
             otmp->oclass != GEM_CLASS && !obj_resists(otmp, 33, 100)) {
             result = "shatter";
         } else if (otmp->otyp == EGG && !rn2(3)) {
@@ -1417,7 +1417,7 @@ ship_object(struct obj *otmp, xchar x, xchar y, boolean shop_floor_obj)
     if (breaktest(otmp)) {
         const char *result;
 
-        if (objects[otmp->otyp].oc_material == GLASS ||
+        if (objstate[otmp->otyp].oc_material == GLASS ||
             otmp->otyp == EXPENSIVE_CAMERA) {
             if (otmp->otyp == MIRROR)
                 change_luck(-2);
@@ -1460,7 +1460,7 @@ deliver_object(struct obj *obj, xchar dnum, xchar dlevel, int where)
     d_level levnum = { dnum, dlevel };
     int nx, ny;
 
-    lev = levels[ledger_no(&levnum)];
+    lev = level_by_ledger(ledger_no(&levnum));
     if (!lev) { /* this can go away if we pre-generate all levels */
         /* Reset the rndmonst state so that it will generate correct monsters
            for the level being created. */
@@ -226,10 +226,11 @@ autoquiver(void)
             ;   /* Skip it */
         } else if (otmp->otyp == ROCK ||
                    /* seen rocks or known flint or known glass */
-                   (objects[otmp->otyp].oc_name_known && otmp->otyp == FLINT) ||
-                   (objects[otmp->otyp].oc_name_known &&
+                   (objstate[otmp->otyp].oc_name_known &&
+                    otmp->otyp == FLINT) ||
+                   (objstate[otmp->otyp].oc_name_known &&
                     otmp->oclass == GEM_CLASS &&
-                    objects[otmp->otyp].oc_material == GLASS)) {
+                    objstate[otmp->otyp].oc_material == GLASS)) {
             if (uslinging())
                 oammo = otmp;
             else if (ammo_and_launcher(otmp, uswapwep))
@@ -778,7 +779,7 @@ toss_up(struct obj *obj, boolean hitsroof)
             else if (dmg > 6)
                 dmg = 6;
             if (youmonst.data == &mons[PM_SHADE] &&
-                objects[obj->otyp].oc_material != SILVER)
+                objstate[obj->otyp].oc_material != SILVER)
                 dmg = 0;
         }
         if (dmg > 1 && less_damage)
@@ -1430,7 +1431,7 @@ gem_accept(struct monst *mon, struct obj *obj)
 {
     char buf[BUFSZ];
     boolean is_buddy = sgn(mon->data->maligntyp) == sgn(u.ualign.type);
-    boolean is_gem = objects[obj->otyp].oc_material == GEMSTONE;
+    boolean is_gem = objstate[obj->otyp].oc_material == GEMSTONE;
     int ret = 0;
     static const char nogood[] = " is not interested in your junk.";
     static const char acceptgift[] = " accepts your gift.";
@@ -1443,7 +1444,7 @@ gem_accept(struct monst *mon, struct obj *obj)
     mon->mavenge = 0;
 
     /* object properly identified */
-    if (obj->dknown && objects[obj->otyp].oc_name_known) {
+    if (obj->dknown && objstate[obj->otyp].oc_name_known) {
         if (is_gem) {
             if (is_buddy) {
                 strcat(buf, addluck);
@@ -1457,7 +1458,7 @@ gem_accept(struct monst *mon, struct obj *obj)
             goto nopick;
         }
         /* making guesses */
-    } else if (obj->onamelth || objects[obj->otyp].oc_uname) {
+    } else if (obj->onamelth || objstate[obj->otyp].oc_uname) {
         if (is_gem) {
             if (is_buddy) {
                 strcat(buf, addluck);
@@ -1651,7 +1652,7 @@ breaktest(struct obj *obj)
 {
     if (obj_resists(obj, 1, 99))
         return 0;
-    if (objects[obj->otyp].oc_material == GLASS && !obj->oartifact &&
+    if (objstate[obj->otyp].oc_material == GLASS && !obj->oartifact &&
         obj->oclass != GEM_CLASS)
         return 1;
     switch (obj->oclass == POTION_CLASS ? POT_WATER : obj->otyp) {
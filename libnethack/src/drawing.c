@@ -285,7 +285,7 @@ make_object_name(int otyp)
     char buffer[41], buf2[41];
     const char *nameptr;
     char *ret;
-    int class = (int)const_objects[otyp].oc_class;
+    int class = (int)objects[otyp].oc_class;
 
 
     buffer[0] = buf2[0] = '\0';
@@ -295,13 +295,14 @@ make_object_name(int otyp)
 
     /* catch dummy objects (scrolls, wands, ...) without names */
     if (!nameptr) {
-        unnamed_cnt[(int)const_objects[otyp].oc_class]++;
+        unnamed_cnt[(int)objects[otyp].oc_class]++;
         snprintf(buf2, 40, "unnamed %d", unnamed_cnt[class]);
     }
 
-    if (class == AMULET_CLASS && const_objects[otyp].oc_material == PLASTIC) {
+    if (class == AMULET_CLASS && const_objstate[otyp].oc_material == PLASTIC) {
         snprintf(buf2, 40, "fake amulet of yendor");
-    } else if (class == GEM_CLASS && const_objects[otyp].oc_material == GLASS) {
+    } else if (class == GEM_CLASS &&
+               const_objstate[otyp].oc_material == GLASS) {
         snprintf(buf2, 40, "%s glass gem", obj_descr[otyp].oc_descr);
     }
 
@@ -361,9 +362,9 @@ nh_get_drawing_info(void)
     di->num_objects = NUM_OBJECTS;
     tmp = xmalloc(sizeof (struct nh_symdef) * di->num_objects);
     for (i = 0; i < di->num_objects; i++) {
-        tmp[i].ch = def_oc_syms[(int)const_objects[i].oc_class];
+        tmp[i].ch = def_oc_syms[(int)objects[i].oc_class];
         tmp[i].symname = make_object_name(i);
-        tmp[i].color = const_objects[i].oc_color;
+        tmp[i].color = const_objstate[i].oc_color;
     }
     di->objects = tmp;
 
@@ -70,7 +70,7 @@ freelevchn(void)
 
 
 void
-free_dungeon(void)
+free_branches(void)
 {
     branch *curr, *next;
 
@@ -79,7 +79,13 @@ free_dungeon(void)
         free(curr);
     }
     branches = NULL;
+}
+
 
+void
+free_dungeon(void)
+{
+    free_branches();
     freelevchn();
 }
 
@@ -1465,6 +1471,15 @@ level_difficulty(const d_level * dlev)
         return (xchar) depth(dlev);
 }
 
+/* Seen and not forgotten; doesn't restore a cold level to find out. */
+static boolean
+level_remembered(xchar ledger)
+{
+    struct overview_info oi;
+
+    return level_overview(ledger, &oi) && !oi.forgotten;
+}
+
 /* Take one word and try to match it to a level.
  * Recognized levels are as shown by print_dungeon().
  */
@@ -1504,7 +1519,7 @@ lev_by_name(const char *nam)
              (u.uz.dnum == medusa_level.dnum &&
               dlev.dnum == valley_level.dnum)) &&
             /* either wizard mode or else seen and not forgotten */
-            (wizard || (levels [idx] && !levels [idx]->flags.forgotten)))
+            (wizard || level_remembered(idx)))
         {
             lev = depth(&slev->dlevel);
         }
@@ -1519,9 +1534,8 @@ lev_by_name(const char *nam)
             idx &= 0x00FF;
             if (        /* either wizard mode, or else _both_ sides of branch
                            seen */
-                   wizard || ((levels[idx] && !levels[idx]->flags.forgotten) &&
-                              (levels[idxtoo] &&
-                               !levels[idxtoo]->flags.forgotten))) {
+                   wizard || (level_remembered(idx) &&
+                              level_remembered(idxtoo))) {
                 if (ledger_to_dnum(idxtoo) == u.uz.dnum)
                     idx = idxtoo;
                 dlev.dnum = ledger_to_dnum(idx);
@@ -1762,18 +1776,14 @@ donamelevel(void)
 
 
 static boolean
-overview_is_interesting(const struct level *lev, const struct overview_info *oi)
+overview_is_interesting(xchar ledger, const struct overview_info *oi)
 {
-    /* not interesting if it hasn't been created yet */
-    if (!lev)
-        return FALSE;
-
     /* interesting if you're on this level */
-    if (lev == level)
+    if (levels[ledger] && levels[ledger] == level)
         return TRUE;
 
     /* interesting if it is named ("stash", "danger, demon!") */
-    if (*lev->levname)
+    if (*oi->levname)
         return TRUE;
 
     /* if overview_scan found _anything_ the level is also interesting */
@@ -1786,7 +1796,9 @@ overview_is_interesting(const struct level *lev, const struct overview_info *oi)
 }
 
 
-static void
+/* Doesn't check whether the destinations of branches and portals exist;
+   level_overview() does that. */
+void
 overview_scan(const struct level *lev, struct overview_info *oi)
 {
     int x, y, rnum, rtyp;
@@ -1798,6 +1810,9 @@ overview_scan(const struct level *lev, struct overview_info *oi)
     if (!lev)
         return;
 
+    oi->forgotten = lev->flags.forgotten;
+    strcpy(oi->levname, lev->levname);
+
     for (y = 0; y < ROWNO; y++) {
         for (x = 0; x < COLNO; x++) {
             if (!lev->locations[x][y].seenv)
@@ -1810,8 +1825,7 @@ overview_scan(const struct level *lev, struct overview_info *oi)
             case S_dnladder:
             case S_upsstair:
             case S_dnsstair:
-                if (lev->sstairs.sx == x && lev->sstairs.sy == y &&
-                    levels[ledger_no(&lev->sstairs.tolev)]) {
+                if (lev->sstairs.sx == x && lev->sstairs.sy == y) {
                     oi->branch = TRUE;
                     oi->branch_dst = lev->sstairs.tolev;
                 }
@@ -1860,8 +1874,7 @@ overview_scan(const struct level *lev, struct overview_info *oi)
 
     /* find the magic portal, if it exists */
     for (trap = lev->lev_traps; trap; trap = trap->ntrap)
-        if (trap->tseen && trap->ttyp == MAGIC_PORTAL &&
-            levels[ledger_no(&trap->dst)]) {
+        if (trap->tseen && trap->ttyp == MAGIC_PORTAL) {
             oi->portal = TRUE;
             oi->portal_dst = trap->dst;
         }
@@ -1869,9 +1882,9 @@ overview_scan(const struct level *lev, struct overview_info *oi)
 
 
 static void
-overview_print_dun(char *buf, const struct level *lev)
+overview_print_dun(char *buf, const d_level *z)
 {
-    int dnum = lev->z.dnum;
+    int dnum = z->dnum;
     int depthstart = dungeons[dnum].depth_start;
     int entry_depth, reached_depth;
 
@@ -1881,7 +1894,7 @@ overview_print_dun(char *buf, const struct level *lev)
 
     entry_depth = depthstart + dungeons[dnum].entry_lev - 1;
     reached_depth = depthstart + dungeons[dnum].dunlev_ureached - 1;
-    if (entry_depth == reached_depth || In_endgame(&lev->z))
+    if (entry_depth == reached_depth || In_endgame(z))
         /* Suppress the negative numbers in the endgame. */
         sprintf(buf, "%s:", dungeons[dnum].dname);
     else {
@@ -1893,20 +1906,21 @@ overview_print_dun(char *buf, const struct level *lev)
 
 
 static void
-overview_print_lev(char *buf, const struct level *lev)
+overview_print_lev(char *buf, const d_level *z, const char *levname,
+                   boolean here)
 {
     int i, depthstart;
 
-    depthstart = dungeons[lev->z.dnum].depth_start;
-    if (lev->z.dnum == quest_dnum || lev->z.dnum == knox_level.dnum)
+    depthstart = dungeons[z->dnum].depth_start;
+    if (z->dnum == quest_dnum || z->dnum == knox_level.dnum)
         /* The quest and knox should appear to be level 1 to match other text. */
         depthstart = 1;
 
     /* calculate level number */
-    i = depthstart + lev->z.dlevel - 1;
-    if (Is_astralevel(&lev->z))
+    i = depthstart + z->dlevel - 1;
+    if (Is_astralevel(z))
         sprintf(buf, "Astral Plane");
-    else if (In_endgame(&lev->z))
+    else if (In_endgame(z))
         /* Negative numbers are mildly confusing, since they are never shown to 
            the player, except in wizard mode.  We could show "Level -1" for the 
            earth plane, for example.  Instead, show "Plane 1" for the earth
@@ -1916,13 +1930,12 @@ overview_print_lev(char *buf, const struct level *lev)
     else
         sprintf(buf, "Level %d", i);
 
-    if (*lev->levname)
-        sprintf(eos(buf), " (%s)", lev->levname);
+    if (*levname)
+        sprintf(eos(buf), " (%s)", levname);
 
     sprintf(eos(buf), "%s",
-            lev ==
-            level ? (program_state.
-                     gameover ? " <- You were here" : " <- You are here") : "");
+            here ? (program_state.
+                    gameover ? " <- You were here" : " <- You are here") : "");
 }
 
 
@@ -2014,6 +2027,7 @@ dooverview(void)
     int i, n, x, y, dnum, selected[1];
     char buf[BUFSZ];
     struct level *lev;
+    d_level z;
 
     init_menulist(&menu);
 
@@ -2024,23 +2038,26 @@ dooverview(void)
 
     dnum = -1;
     for (i = 0; i < maxledgerno(); i++) {
-        if (!levels[i])
+        /* cold levels are listed without restoring them */
+        if (!level_overview(i, &oinfo))
             continue;
-        overview_scan(levels[i], &oinfo);
+        z.dnum = ledger_to_dnum(i);
+        z.dlevel = ledger_to_dlev(i);
 
-        if (levels[i]->z.dnum != dnum) {
+        if (z.dnum != dnum) {
             if (i > 0)
                 add_menutext(&menu, "");
-            overview_print_dun(buf, levels[i]);
+            overview_print_dun(buf, &z);
             add_menuheading(&menu, buf);
-            dnum = levels[i]->z.dnum;
+            dnum = z.dnum;
         }
 
         /* "Level 3 (my level name)" */
-        overview_print_lev(buf, levels[i]);
+        overview_print_lev(buf, &z, oinfo.levname,
+                           levels[i] && levels[i] == level);
         add_menuitem(&menu, i + 1, buf, 0, FALSE);
 
-        if (!overview_is_interesting(levels[i], &oinfo))
+        if (!overview_is_interesting(i, &oinfo))
             continue;
 
         /* "some fountains, an altar" */
@@ -2061,8 +2078,8 @@ dooverview(void)
     if (n <= 0)
         return 0;
 
-    /* remote viewing */
-    lev = levels[selected[0] - 1];
+    /* remote viewing; only the level being looked at has to be restored */
+    lev = level_by_ledger(selected[0] - 1);
     if (level == lev)
         return 0;
 
@@ -2076,7 +2093,7 @@ dooverview(void)
                      lev->locations[x][y].mem_invis, 0, 0, 0,
                      dbuf_branding(&lev->locations[x][y]));
 
-    overview_print_lev(buf, lev);
+    overview_print_lev(buf, &lev->z, lev->levname, FALSE);
     pline("Now viewing %s%s.  Press any key to return.",
           Is_astralevel(&lev->z) ? "the " : "", buf);
     flush_screen_nopos();
@@ -1547,10 +1547,10 @@ foodword(struct obj *otmp)
 {
     if (otmp->oclass == FOOD_CLASS)
         return "food";
-    if (otmp->oclass == GEM_CLASS && objects[otmp->otyp].oc_material == GLASS &&
-        otmp->dknown)
+    if (otmp->oclass == GEM_CLASS &&
+        objstate[otmp->otyp].oc_material == GLASS && otmp->dknown)
         makeknown(otmp->otyp);
-    return foodwords[objects[otmp->otyp].oc_material];
+    return foodwords[objstate[otmp->otyp].oc_material];
 }
 
 /* called after consuming (non-corpse) food */
@@ -1640,7 +1640,7 @@ edibility_prompts(struct obj *otmp)
     char buf[BUFSZ], foodsmell[BUFSZ], it_or_they[QBUFSZ],
         eat_it_anyway[QBUFSZ];
     boolean cadaver = (otmp->otyp == CORPSE), stoneorslime = FALSE;
-    int material = objects[otmp->otyp].oc_material, mnum = otmp->corpsenm;
+    int material = objstate[otmp->otyp].oc_material, mnum = otmp->corpsenm;
     long rotted = 0L;
 
     strcpy(foodsmell, Tobjnam(otmp, "smell"));
@@ -1866,8 +1866,8 @@ doeat(struct obj *otmp)
     if (otmp->otyp == RIN_SLOW_DIGESTION) {
         pline("This ring is indigestible!");
         rottenfood(otmp);
-        if (otmp->dknown && !objects[otmp->otyp].oc_name_known &&
-            !objects[otmp->otyp].oc_uname)
+        if (otmp->dknown && !objstate[otmp->otyp].oc_name_known &&
+            !objstate[otmp->otyp].oc_uname)
             docall(otmp);
         return 1;
     }
@@ -1899,7 +1899,7 @@ doeat(struct obj *otmp)
         victual.nmod = basenutrit;
         victual.eating = TRUE;  /* needed for lesshungry() */
 
-        material = objects[otmp->otyp].oc_material;
+        material = objstate[otmp->otyp].oc_material;
         if (material == LEATHER || material == BONE || material == DRAGON_HIDE) {
             u.uconduct.unvegan++;
             violated_vegetarian();
@@ -1970,7 +1970,7 @@ doeat(struct obj *otmp)
     } else {
         /* No checks for WAX, LEATHER, BONE, DRAGON_HIDE.  These are all
            handled in the != FOOD_CLASS case, above */
-        switch (objects[otmp->otyp].oc_material) {
+        switch (objstate[otmp->otyp].oc_material) {
         case FLESH:
             u.uconduct.unvegan++;
             if (otmp->otyp != EGG) {
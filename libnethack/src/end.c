@@ -170,6 +170,7 @@ panic(const char *str, ...)
 
     va_start(the_args, str);
 
+    pregen_worker_abort();      /* a worker mustn't save or log anything */
     if (program_state.panicking++)
         terminate();    /* avoid loops - this should never happen */
 
@@ -435,7 +436,7 @@ static int artifact_score(struct obj *list,
                         the_unique_obj(otmp) ? "The " : "",
                         otmp->oartifact ?
                         artifact_name(xname(otmp), &dummy) :
-                        OBJ_NAME(objects[otmp->otyp]), value, currency(value));
+                        OBJ_NAME(otmp->otyp), value, currency(value));
                 add_menutext(menu, pbuf);
             }
         }
@@ -882,6 +883,8 @@ done_noreturn(int how)
     struct obj *corpse = NULL;
     long umoney;
 
+    pregen_worker_abort();
+
     /* replays are done here: no dumping or high-score calculation required */
     if (program_state.viewing)
         terminate();
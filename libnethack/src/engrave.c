@@ -588,7 +588,7 @@ doengrave_core(struct obj *otmp, int auto_elbereth)
         /* "diamond" rings and others should work */
     case GEM_CLASS:
         /* diamonds & other hard gems should work */
-        if (objects[otmp->otyp].oc_tough) {
+        if (objstate[otmp->otyp].oc_tough) {
             type = ENGRAVE;
             break;
         }
@@ -735,7 +735,7 @@ doengrave_core(struct obj *otmp, int auto_elbereth)
             case WAN_DIGGING:
                 ptext = TRUE;
                 type = ENGRAVE;
-                if (!objects[otmp->otyp].oc_name_known) {
+                if (!objstate[otmp->otyp].oc_name_known) {
                     if (flags.verbose)
                         pline("This %s is a wand of digging!", xname(otmp));
                     doknown = TRUE;
@@ -756,7 +756,7 @@ doengrave_core(struct obj *otmp, int auto_elbereth)
             case WAN_FIRE:
                 ptext = TRUE;
                 type = BURN;
-                if (!objects[otmp->otyp].oc_name_known) {
+                if (!objstate[otmp->otyp].oc_name_known) {
                     if (flags.verbose)
                         pline("This %s is a wand of fire!", xname(otmp));
                     doknown = TRUE;
@@ -768,7 +768,7 @@ doengrave_core(struct obj *otmp, int auto_elbereth)
             case WAN_LIGHTNING:
                 ptext = TRUE;
                 type = BURN;
-                if (!objects[otmp->otyp].oc_name_known) {
+                if (!objstate[otmp->otyp].oc_name_known) {
                     if (flags.verbose)
                         pline("This %s is a wand of lightning!", xname(otmp));
                     doknown = TRUE;
@@ -507,7 +507,7 @@ scatter(int sx, int sy, /* location of objects to scatter */
 
             /* 1 in 10 chance of destruction of obj; glass, egg destruction */
         } else if ((scflags & MAY_DESTROY) &&
-                   (!rn2(10) || (objects[otmp->otyp].oc_material == GLASS ||
+                   (!rn2(10) || (objstate[otmp->otyp].oc_material == GLASS ||
                                  otmp->otyp == EGG))) {
             if (breaks(otmp, (xchar) sx, (xchar) sy))
                 used_up = TRUE;
@@ -551,7 +551,7 @@ drinksink(void)
         } while (!otmp);
         otmp->cursed = otmp->blessed = 0;
         pline("Some %s liquid flows from the faucet.",
-              Blind ? "odd" : hcolor(OBJ_DESCR(objects[otmp->otyp])));
+              Blind ? "odd" : hcolor(OBJ_DESCR(otmp->otyp)));
         otmp->dknown = !(Blind || Hallucination);
         otmp->quan++;   /* Avoid panic upon useup() */
         otmp->fromsink = 1;     /* kludge for docall() */
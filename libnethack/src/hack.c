@@ -11,6 +11,7 @@ static void dosinkfall(void);
 static boolean findtravelpath(boolean(*)(int, int), schar *, schar *);
 static struct monst *monstinroom(const struct permonst *, int);
 static boolean check_interrupt(struct monst *mtmp);
+static boolean interrupting_monster_near(int range);
 
 static void move_update(boolean);
 
@@ -700,7 +701,7 @@ test_move(int ux, int uy, int dx, int dy, int dz, int mode)
                     !(tunnels(youmonst.data) && !needspick(youmonst.data)) &&
                     !carrying(PICK_AXE) && !carrying(DWARVISH_MATTOCK) &&
                     !((obj = carrying(WAN_DIGGING)) &&
-                      !objects[obj->otyp].oc_name_known))
+                      !objstate[obj->otyp].oc_name_known))
                     return FALSE;
             }
         }
@@ -711,18 +712,52 @@ test_move(int ux, int uy, int dx, int dy, int dz, int mode)
     return TRUE;
 }
 
+/* Squares next to a square that the hero remembers as stone (or doesn't
+   remember at all) and that has no stepped-on square around it.  This is the
+   part of unexplored() that depends on a 5x5 area; it is worked out for the
+   whole level in a few passes at the start of each autoexplore search. */
+static boolean explore_frontier[COLNO][ROWNO];
+
+static void
+find_explore_frontier(void)
+{
+    static boolean stepped_near[COLNO][ROWNO];
+    int x, y, i, j;
+
+    memset(stepped_near, 0, sizeof (stepped_near));
+    memset(explore_frontier, 0, sizeof (explore_frontier));
+
+    for (x = 1; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++)
+            if (level->locations[x][y].mem_stepped)
+                for (i = x - 1; i <= x + 1; i++)
+                    for (j = y - 1; j <= y + 1; j++)
+                        if (isok(i, j))
+                            stepped_near[i][j] = TRUE;
+
+    for (x = 1; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++)
+            if ((level->locations[x][y].mem_bg == S_stone ||
+                 level->locations[x][y].mem_bg == S_unexplored) &&
+                !stepped_near[x][y])
+                for (i = x - 1; i <= x + 1; i++)
+                    for (j = y - 1; j <= y + 1; j++)
+                        if (isok(i, j))
+                            explore_frontier[i][j] = TRUE;
+}
+
 /* Returns whether a square might be interesting to autoexplore onto.
    This is done purely in terms of the memory of the square, i.e.
    information the player knows already, to avoid leaking
    information. The algorithm is taken from TAEB: "step on any item we
    haven't stepped on, or any square we haven't stepped on adjacent to
    stone that isn't adjacent to a square that has been stepped on;
-   however, never step on a boulder this way". */
+   however, never step on a boulder this way".  find_explore_frontier() must
+   have been called since the hero's memory of the level last changed. */
 static boolean
 unexplored(int x, int y)
 {
-    int i, j, k, l;
-    struct trap *ttmp = t_at(level, x, y);
+    struct trap *ttmp;
 
     if (!isok(x, y))
         return FALSE;
@@ -734,31 +769,186 @@ unexplored(int x, int y)
             (level->locations[x][y].flags & D_LOCKED))
             return FALSE;       /* player knows of a locked door there */
     }
+    if (!level->locations[x][y].mem_obj && !explore_frontier[x][y])
+        return FALSE;
+    ttmp = t_at(level, x, y);
     if (ttmp && ttmp->tseen)
         return FALSE;
     if (level->locations[x][y].mem_obj == what_obj(BOULDER) + 1)
         return FALSE;
     if (level->locations[x][y].mem_obj && inside_shop(level, x, y))
         return FALSE;
-    if (level->locations[x][y].mem_obj)
-        return TRUE;
-    for (i = -1; i <= 1; i++)
-        for (j = -1; j <= 1; j++) {
-            if (isok(x + i, y + j) &&
-                (level->locations[x + i][y + j].mem_bg == S_stone ||
-                 level->locations[x + i][y + j].mem_bg == S_unexplored)) {
-                int flag = TRUE;
-
-                for (k = -1; k <= 1; k++)
-                    for (l = -1; l <= 1; l++)
-                        if (isok(x + i + k, y + j + l) &&
-                            level->locations[x + i + k][y + j + l].mem_stepped)
-                            flag = FALSE;
-                if (flag)
-                    return TRUE;
+    return TRUE;
+}
+
+/*
+ * Travel edge cache.
+ *
+ * findtravelpath() repeats its breadth-first search on every step of a travel
+ * command.  The order of that search depends on where the hero is and on what
+ * the hero can see right now, so it has to be repeated to get the same moves,
+ * but nearly all of its time goes into test_move() and the closed door and
+ * boulder checks for each edge, and those only depend on the squares around
+ * the edge and a few properties of the hero.  Their results are kept here and
+ * recomputed only around squares whose terrain, door state, boulders or seen
+ * traps changed, or everywhere if something about the hero changed.
+ *
+ * test_move() exempts the hero's own square from the trap check, so edges
+ * into it are never cached; and shopkeepers may block doors depending on where
+ * the hero is, so the cache is bypassed while in a shop or on a broken door.
+ */
+
+#define TC_BOULDER      0x01
+#define TC_SEENTRAP     0x02
+#define TC_SEEN         0x04
+
+struct travel_cell {
+    schar typ;
+    uchar flags;
+    uchar state;        /* TC_* */
+    boolean delay_known, delay;
+    uchar trap_known, trap_ok;  /* one bit per direction */
+    uchar trav_known, trav_ok;
+};
+
+static struct {
+    boolean valid, usable;
+    struct level *lev;
+    const struct permonst *data;
+    int run;
+    boolean passes_walls, can_ooze, levitating, flying, bulky, digger;
+    struct travel_cell cells[COLNO][ROWNO];
+} travel_cache;
+
+static void
+forget_travel_edges(int x, int y)
+{
+    int i, j;
+
+    for (i = x - 1; i <= x + 1; i++)
+        for (j = y - 1; j <= y + 1; j++)
+            if (isok(i, j)) {
+                struct travel_cell *tc = &travel_cache.cells[i][j];
+
+                tc->delay_known = FALSE;
+                tc->trap_known = tc->trav_known = 0;
+            }
+}
+
+/* Bring the cache up to date before a search. */
+static void
+update_travel_cache(void)
+{
+    static uchar state[COLNO][ROWNO];
+    struct rm *loc = &level->locations[u.ux][u.uy];
+    struct trap *trap;
+    struct obj *obj;
+    boolean passes_walls, can_ooze_, levitating, flying, bulky, digger;
+    int x, y;
+
+    travel_cache.usable = !*u.ushops &&
+        !(IS_DOOR(loc->typ) && loc->doormask == D_BROKEN);
+    if (!travel_cache.usable)
+        return;
+
+    /* everything about the hero that test_move(TEST_TRAP/TEST_TRAV) looks at,
+       other than the position */
+    passes_walls = !!Passes_walls;
+    can_ooze_ = can_ooze(&youmonst);
+    levitating = !!Levitation;
+    flying = !!Flying;
+    bulky = invent && (inv_weight() + weight_cap() > 600);
+    digger = carrying(PICK_AXE) || carrying(DWARVISH_MATTOCK) ||
+        ((obj = carrying(WAN_DIGGING)) && !objstate[obj->otyp].oc_name_known);
+
+    if (iflags.travel1 || !travel_cache.valid || travel_cache.lev != level ||
+        travel_cache.data != youmonst.data || travel_cache.run != flags.run ||
+        travel_cache.passes_walls != passes_walls ||
+        travel_cache.can_ooze != can_ooze_ ||
+        travel_cache.levitating != levitating ||
+        travel_cache.flying != flying || travel_cache.bulky != bulky ||
+        travel_cache.digger != digger) {
+        memset(travel_cache.cells, 0, sizeof (travel_cache.cells));
+        for (x = 0; x < COLNO; x++)
+            for (y = 0; y < ROWNO; y++)
+                travel_cache.cells[x][y].typ = -1;      /* not a valid typ */
+        travel_cache.valid = TRUE;
+        travel_cache.lev = level;
+        travel_cache.data = youmonst.data;
+        travel_cache.run = flags.run;
+        travel_cache.passes_walls = passes_walls;
+        travel_cache.can_ooze = can_ooze_;
+        travel_cache.levitating = levitating;
+        travel_cache.flying = flying;
+        travel_cache.bulky = bulky;
+        travel_cache.digger = digger;
+    }
+
+    memset(state, 0, sizeof (state));
+    for (trap = level->lev_traps; trap; trap = trap->ntrap)
+        if (trap->tseen && t_at(level, trap->tx, trap->ty) == trap)
+            state[trap->tx][trap->ty] |= TC_SEENTRAP;
+
+    for (x = 1; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++) {
+            struct travel_cell *tc = &travel_cache.cells[x][y];
+
+            loc = &level->locations[x][y];
+            if (loc->seenv)
+                state[x][y] |= TC_SEEN;
+            if (level->objects[x][y] && sobj_at(BOULDER, level, x, y))
+                state[x][y] |= TC_BOULDER;
+
+            if (tc->typ != loc->typ || tc->flags != loc->flags ||
+                tc->state != state[x][y]) {
+                forget_travel_edges(x, y);
+                tc->typ = loc->typ;
+                tc->flags = loc->flags;
+                tc->state = state[x][y];
             }
         }
-    return FALSE;
+}
+
+/* test_move() for the edge from (x,y) in direction dir */
+static boolean
+travel_test_move(int x, int y, int dir, int mode)
+{
+    struct travel_cell *tc = &travel_cache.cells[x][y];
+    uchar *known = mode == TEST_TRAP ? &tc->trap_known : &tc->trav_known;
+    uchar *ok = mode == TEST_TRAP ? &tc->trap_ok : &tc->trav_ok;
+    uchar bit = 1 << dir;
+
+    if (!travel_cache.usable ||
+        (x + xdir[dir] == u.ux && y + ydir[dir] == u.uy))
+        return test_move(x, y, xdir[dir], ydir[dir], 0, mode);
+
+    if (!(*known & bit)) {
+        *known |= bit;
+        if (test_move(x, y, xdir[dir], ydir[dir], 0, mode))
+            *ok |= bit;
+        else
+            *ok &= ~bit;
+    }
+    return (*ok & bit) != 0;
+}
+
+/* closed doors and boulders usually cause a delay */
+static boolean
+travel_delays(int x, int y)
+{
+    struct travel_cell *tc = &travel_cache.cells[x][y];
+
+    if (!travel_cache.usable || !tc->delay_known) {
+        boolean delay = (!Passes_walls && !can_ooze(&youmonst) &&
+                         closed_door(level, x, y)) ||
+            sobj_at(BOULDER, level, x, y);
+
+        if (!travel_cache.usable)
+            return delay;
+        tc->delay_known = TRUE;
+        tc->delay = delay;
+    }
+    return tc->delay;
 }
 
 /*
@@ -792,6 +982,11 @@ findtravelpath(boolean(*guess) (int, int), schar * dx, schar * dy)
         int set = 0;    /* two sets current and previous */
         int radius = 1; /* search radius */
         int i;
+        boolean found_unexplored = FALSE;
+
+        update_travel_cache();
+        if (guess == unexplored)
+            find_explore_frontier();
 
         /* If guessing, first find an "obvious" goal location.  The obvious
            goal is the position the player knows of, or might figure out
@@ -810,6 +1005,7 @@ findtravelpath(boolean(*guess) (int, int), schar * dx, schar * dy)
 
     noguess:
         memset(travel, 0, sizeof (travel));
+        found_unexplored = FALSE;
         travelstepx[0][0] = tx;
         travelstepy[0][0] = ty;
 
@@ -831,10 +1027,8 @@ findtravelpath(boolean(*guess) (int, int), schar * dx, schar * dy)
 
                     if (!isok(nx, ny))
                         continue;
-                    if ((!Passes_walls && !can_ooze(&youmonst) &&
-                         closed_door(level, x, y)) ||
-                        sobj_at(BOULDER, level, x, y) ||
-                        test_move(x, y, nx - x, ny - y, 0, TEST_TRAP)) {
+                    if (travel_delays(x, y) ||
+                        travel_test_move(x, y, ordered[dir], TEST_TRAP)) {
                         /* closed doors and boulders usually cause a delay, so
                            prefer another path */
                         if ((int)travel[x][y] > radius - 5) {
@@ -848,8 +1042,8 @@ findtravelpath(boolean(*guess) (int, int), schar * dx, schar * dy)
                             continue;
                         }
                     }
-                    if (test_move(x, y, nx - x, ny - y, 0, TEST_TRAP) ||
-                        test_move(x, y, nx - x, ny - y, 0, TEST_TRAV)) {
+                    if (travel_test_move(x, y, ordered[dir], TEST_TRAP) ||
+                        travel_test_move(x, y, ordered[dir], TEST_TRAV)) {
                         if ((level->locations[nx][ny].seenv ||
                              (!Blind && couldsee(nx, ny)))) {
                             if (nx == ux && ny == uy) {
@@ -870,6 +1064,8 @@ findtravelpath(boolean(*guess) (int, int), schar * dx, schar * dy)
                                 travelstepy[1 - set][nn] = ny;
                                 travel[nx][ny] = radius;
                                 nn++;
+                                if (guess == unexplored && unexplored(nx, ny))
+                                    found_unexplored = TRUE;
                             }
                         }
                     }
@@ -879,6 +1075,12 @@ findtravelpath(boolean(*guess) (int, int), schar * dx, schar * dy)
             n = nn;
             set = 1 - set;
             radius++;
+
+            /* The guess below picks the closest unexplored square, so once one
+               was reached, there's no point in searching any further than
+               the other squares at the same distance. */
+            if (found_unexplored)
+                break;
         }
 
         /* if guessing, find best location in travel matrix and go there */
@@ -2065,14 +2267,10 @@ lookaround(void)
     }
 
     /* If travel_interrupt is set, then stop if there is a hostile nearby. */
-    if (flags.run != 1 && iflags.travel_interrupt) {
-        for (mtmp = level->monlist; mtmp; mtmp = mtmp->nmon) {
-            if (distmin(u.ux, u.uy, mtmp->mx, mtmp->my) <= (BOLT_LIM + 1) &&
-                couldsee(mtmp->mx, mtmp->my) && check_interrupt(mtmp)) {
-                nomul(0, NULL);
-                return;
-            }
-        }
+    if (flags.run != 1 && iflags.travel_interrupt &&
+        interrupting_monster_near(BOLT_LIM + 1)) {
+        nomul(0, NULL);
+        return;
     }
 
     if (Blind || flags.run == 0)
@@ -2210,6 +2408,59 @@ check_interrupt(struct monst *mtmp)
             !onscary(u.ux, u.uy, mtmp) && canspotmon(mtmp));
 }
 
+/* Is there a monster within range of the hero, in a spot the hero could see,
+   that check_interrupt() objects to?
+
+   This looks only at the squares within range that level->monbits marks as
+   occupied, rather than at the whole of level->monlist.  That finds the same
+   monsters as long as every monster on the list is also on the map, which is
+   not the case for a steed or for dead monsters that haven't been purged yet;
+   the steed is checked separately, and with dead monsters around the whole
+   list is searched like it used to be. */
+static boolean
+interrupting_monster_near(int range)
+{
+    struct monst *mtmp;
+    int x, y, w, nmon = 0;
+    int lox = max(u.ux - range, 0), hix = min(u.ux + range, COLNO - 1);
+    int loy = max(u.uy - range, 0), hiy = min(u.uy + range, ROWNO - 1);
+    boolean found = FALSE;
+
+    if (iflags.purge_monsters) {
+        bench_count(BENCH_MONLIST_WALKS, 1);
+        for (mtmp = level->monlist; mtmp && !found; mtmp = mtmp->nmon) {
+            nmon++;
+            found = distmin(u.ux, u.uy, mtmp->mx, mtmp->my) <= range &&
+                couldsee(mtmp->mx, mtmp->my) && check_interrupt(mtmp);
+        }
+        bench_count(BENCH_NEARBY_MONSTERS, nmon);
+        return found;
+    }
+
+    if (u.usteed && couldsee(u.ux, u.uy) && check_interrupt(u.usteed))
+        return TRUE;
+
+    for (y = loy; y <= hiy && !found; y++) {
+        for (w = lox / 64; w <= hix / 64; w++)
+            if (level->monbits[y][w])
+                break;
+        if (w > hix / 64)
+            continue;
+        for (x = lox; x <= hix && !found; x++) {
+            if (!(level->monbits[y][x / 64] & MONBIT(x)))
+                continue;
+            mtmp = level->monsters[x][y];
+            /* a long worm's tail segments point to its head */
+            if (!mtmp || mtmp->mx != x || mtmp->my != y)
+                continue;
+            nmon++;
+            found = couldsee(x, y) && check_interrupt(mtmp);
+        }
+    }
+    bench_count(BENCH_NEARBY_MONSTERS, nmon);
+    return found;
+}
+
 
 
 /* something like lookaround, but we are not running */
@@ -23,6 +23,8 @@ static boolean tool_in_use(struct obj *);
 static char obj_to_let(struct obj *);
 static int identify(struct obj *);
 static const char *dfeature_at(int, int, char *);
+static char *inventory_name(struct obj *);
+static boolean invent_key_positions(const struct nh_objitem *, int, short *);
 
 
 enum obj_use_status {
@@ -796,7 +798,7 @@ object_selection_checks(struct obj *otmp, const char *word)
                   (otmp->oclass == GEM_CLASS && !is_graystone(otmp))))
              || (!strncmp(word, "rub on the stone", 16) &&
                  otmp->oclass == GEM_CLASS && /* using known touchstone */
-                 otmp->dknown && objects[otyp].oc_name_known)
+                 otmp->dknown && objstate[otyp].oc_name_known)
              || ((!strcmp(word, "use or apply") || !strcmp(word, "untrap with"))
                  &&
                  /* Picks, axes, pole-weapons, bullwhips */
@@ -806,7 +808,7 @@ object_selection_checks(struct obj *otmp, const char *word)
                    /* only applicable potion is oil, and it will only be
                       offered as a choice when already discovered */
                    (otyp != POT_OIL || !otmp->dknown ||
-                    !objects[POT_OIL].oc_name_known)) ||
+                    !objstate[POT_OIL].oc_name_known)) ||
                   (otmp->oclass == FOOD_CLASS && otyp != CREAM_PIE &&
                    otyp != EUCALYPTUS_LEAF) || (otmp->oclass == GEM_CLASS &&
                                                 !is_graystone(otmp))))
@@ -824,7 +826,7 @@ object_selection_checks(struct obj *otmp, const char *word)
                      mirrors and/or lamps is a simply a cruel deception... */
                   otyp != MIRROR && otyp != MAGIC_LAMP &&
                   (otyp != OIL_LAMP || /* don't list known oil lamp */
-                   (otmp->dknown && objects[OIL_LAMP].oc_name_known))))
+                   (otmp->dknown && objstate[OIL_LAMP].oc_name_known))))
              || (!strcmp(word, "untrap with") &&
                  (otmp->oclass == TOOL_CLASS && otyp != CAN_OF_GREASE))
              || (!strcmp(word, "charge") && !is_chargeable(otmp))
@@ -1348,11 +1350,14 @@ nextclass:
                 if (flags.sortpack && !classcount) {
                     add_objitem(&items, &nr_items, MI_HEADING, cur_entry++, 0,
                                 let_to_name(*invlet, FALSE), otmp, FALSE);
+                    /* the class symbol is the heading's NH_OBJITEM_KEY */
+                    items[cur_entry - 1].group_accel =
+                        def_oc_syms[(int)*invlet];
                     classcount++;
                 }
                 examine_object(otmp);
                 add_objitem(&items, &nr_items, MI_NORMAL, cur_entry++, ilet,
-                            doname(otmp), otmp, TRUE);
+                            inventory_name(otmp), otmp, TRUE);
             }
         }
     }
@@ -1447,20 +1452,158 @@ display_inventory(const char *lets, boolean want_reply)
 }
 
 
+/*
+ * Inventory names are rebuilt for every inventory update, which happens
+ * several times per turn.  Cache each item's doname() together with a copy of
+ * the object and of the global state doname() depends on, and reuse the name
+ * while neither has changed.  Objects whose names depend on state that is not
+ * captured here (shop prices, burn timers, the hero's knowledge of eggs) are
+ * always formatted from scratch.
+ */
+#define INVNAME_CACHE_SIZE 128  /* power of 2 */
+
+struct invname_state {
+    const struct permonst *form;        /* for body_part() */
+    const struct obj *skin;
+    boolean blind, twoweap, mrg_to_wielded, show_uncursed, name_known;
+};
+
+static struct invname_cache {
+    struct obj *copy;   /* including oextra; NULL if the slot is unused */
+    int size;
+    struct invname_state state;
+    char *uname;        /* objstate[].oc_uname at the time */
+    char name[BUFSZ];
+} invname_cache[INVNAME_CACHE_SIZE];
+
+/* inventory as last sent to the window port, if it takes updates */
+static struct nh_objitem *last_invent;
+static int last_invent_count;
+
+
+static char *
+inventory_name(struct obj *obj)
+{
+    struct invname_cache *ic;
+    struct invname_state state;
+    const char *uname = objstate[obj->otyp].oc_uname;
+    int size = sizeof (struct obj) + obj->oxlth + obj->onamelth;
+
+    if (obj->unpaid || ignitable(obj) || obj->otyp == EGG)
+        return doname(obj);
+
+    memset(&state, 0, sizeof (state));
+    state.form = youmonst.data;
+    state.skin = uskin;
+    state.blind = ! !Blind;
+    state.twoweap = u.twoweap;
+    state.mrg_to_wielded = mrg_to_wielded;
+    state.show_uncursed = iflags.show_uncursed;
+    state.name_known = objstate[obj->otyp].oc_name_known;
+
+    ic = &invname_cache[obj->o_id & (INVNAME_CACHE_SIZE - 1)];
+    if (ic->copy && ic->size == size && !memcmp(ic->copy, obj, size) &&
+        !memcmp(&ic->state, &state, sizeof (state)) &&
+        (uname ? ic->uname && !strcmp(ic->uname, uname) : !ic->uname))
+        return ic->name;
+
+    free(ic->copy);
+    free(ic->uname);
+    ic->copy = malloc(size);
+    memcpy(ic->copy, obj, size);
+    ic->size = size;
+    ic->state = state;
+    ic->uname = uname ? strdup(uname) : NULL;
+    strcpy(ic->name, doname(obj));
+    return ic->name;
+}
+
+
+void
+free_invent_cache(void)
+{
+    int i;
+
+    for (i = 0; i < INVNAME_CACHE_SIZE; i++) {
+        free(invname_cache[i].copy);
+        free(invname_cache[i].uname);
+    }
+    memset(invname_cache, 0, sizeof (invname_cache));
+
+    free(last_invent);
+    last_invent = NULL;
+    last_invent_count = 0;
+}
+
+
+/* Fill in the positions of the keys of items in pos, which must have space
+   for 512 entries.  Returns FALSE if a key occurs twice (overflow items all
+   use the same letter), as differences can't be expressed by key then. */
+static boolean
+invent_key_positions(const struct nh_objitem *items, int icount, short *pos)
+{
+    int i, key;
+
+    for (i = 0; i < 512; i++)
+        pos[i] = -1;
+    for (i = 0; i < icount; i++) {
+        key = NH_OBJITEM_KEY(&items[i]) + 256;
+        if (pos[key] != -1)
+            return FALSE;
+        pos[key] = i;
+    }
+    return TRUE;
+}
+
+
 void
 update_inventory(void)
 {
-    int icount = 0;
-    struct nh_objitem *items;
+    int icount = 0, nchanged = 0, i, key;
+    struct nh_objitem *items, *changed;
+    int *order;
+    short lastpos[512], newpos[512];
+    boolean same_order;
 
     if (!windowprocs.win_list_items || program_state.restoring)
         return;
 
     items = make_invlist(NULL, &icount);
-    win_list_items(items, icount, TRUE);
-    free(items);
 
-    return;
+    if (!windowprocs.win_update_inventory || !last_invent ||
+        !invent_key_positions(last_invent, last_invent_count, lastpos) ||
+        !invent_key_positions(items, icount, newpos)) {
+        win_list_items(items, icount, TRUE);
+    } else {
+        changed = malloc(icount * sizeof (struct nh_objitem));
+        order = malloc(icount * sizeof (int));
+        same_order = (icount == last_invent_count);
+        for (i = 0; i < icount; i++) {
+            key = NH_OBJITEM_KEY(&items[i]);
+            order[i] = key;
+            if (lastpos[key + 256] != i)
+                same_order = FALSE;
+            if (lastpos[key + 256] < 0 ||
+                memcmp(&items[i], &last_invent[lastpos[key + 256]],
+                       sizeof (struct nh_objitem)))
+                changed[nchanged++] = items[i];
+        }
+
+        if (nchanged || !same_order)
+            (*windowprocs.win_update_inventory) (changed, nchanged, order,
+                                                 icount);
+        free(changed);
+        free(order);
+    }
+
+    /* only keep the list if the window port will be sent differences to it */
+    free(last_invent);
+    last_invent = NULL;
+    if (windowprocs.win_update_inventory) {
+        last_invent = items;
+        last_invent_count = icount;
+    } else
+        free(items);
 }
 
 
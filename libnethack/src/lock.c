@@ -1016,7 +1016,7 @@ chest_shatter_msg(struct obj *otmp)
     Blinded = 1;
     thing = singular(otmp, xname);
     Blinded = save_Blinded;
-    switch (objects[otmp->otyp].oc_material) {
+    switch (objstate[otmp->otyp].oc_material) {
     case PAPER:
         disposition = "is torn to shreds";
         break;
@@ -264,6 +264,19 @@ log_command(int cmd, int rep, struct nh_cmd_arg *arg)
 }
 
 
+/* nh_command() went on with a multi-turn command without asking the client.
+   Each such step is logged as a '*' token of its own, instead of a whole
+   command and its result; any prompt answers of the step follow it. */
+void
+log_command_continued(void)
+{
+    if (iflags.disable_log || logfile == -1)
+        return;
+
+    lprintf("\n*");
+}
+
+
 void
 log_command_result(void)
 {
@@ -80,19 +80,49 @@ static struct loginfo {
     boolean diffs_are_invalid;
     boolean cmds_are_invalid;
     boolean out_of_sync;
+    int desyncs;        /* diffs that did not match the replayed state */
 } loginfo;
 
+/* compare every diff during REPLAY_GOTO, rather than only the last one */
+static boolean verify_goto = FALSE;
+
 static struct memfile diff_base;
 
+/* Checkpoints are saves of the replayed game that let the viewer go back
+ * without replaying from the start.  Each one holds a compressed save; when
+ * the compressed saves need more memory than cp_budget, the ones that were
+ * used least recently are moved out to a temporary file, and read back when
+ * they are needed again.
+ *
+ * A new checkpoint is made whenever cp_interval actions have passed since
+ * the nearest earlier one (and there isn't one within cp_interval after it
+ * either).  Every seek backwards halves the interval, so that a viewer who
+ * keeps going back gets checkpoints closer together; going forwards over a
+ * few checkpoints in a row doubles it again, up to CHECKPOINT_INTERVAL. */
+#define CHECKPOINT_INTERVAL     1000
+#define CHECKPOINT_MIN_INTERVAL 125
+#define CHECKPOINT_MEMORY       (64ULL * 1024 * 1024)
+
 struct replay_checkpoint {
     int actions, moves, nexttoken;
     struct nh_option_desc *opt; /* option state at the time of the checkpoint */
-    struct memfile cpdata;      /* binary save data */
+    unsigned char *data;        /* compressed save, or NULL if only spilled */
+    unsigned long datalen;
+    unsigned long rawlen;       /* size of the save */
+    long spillpos;      /* where the data is in spill_file, or -1 */
+    unsigned int lastuse;       /* cp_clock when it was last made or loaded */
 };
 
 static struct replay_checkpoint *checkpoints;
 static char **commands;
 static int cmdcount, cpcount;
+
+static unsigned long long cp_budget = CHECKPOINT_MEMORY;  /* 0: no limit */
+static unsigned long long cp_memory;    /* compressed data in memory */
+static unsigned int cp_clock;
+static int cp_interval = CHECKPOINT_INTERVAL;
+static int cp_forward;  /* checkpoints made since the last seek backwards */
+static FILE *spill_file;
 static struct nh_option_desc *saved_options;
 static struct nh_window_procs replay_windowprocs, orig_windowprocs;
 
@@ -1045,6 +1075,8 @@ replay_check_diff(char *token, boolean optonly, boolean fast)
                            "recorded save (length %d)", diff_base.pos, mf.pos);
             }
 #endif
+            if (!loginfo.cmds_are_invalid && !fast)
+                loginfo.desyncs++;
             loginfo.out_of_sync = TRUE;
             mfree(&diff_base);
             diff_base = mf;
@@ -1121,6 +1153,11 @@ replay_run_cmdloop(boolean optonly, boolean singlestep, boolean fast)
                 did_action = TRUE;
             break;
 
+        case '*':      /* one step of a command that went on by itself */
+            if (!optonly && !loginfo.cmds_are_invalid)
+                continue_command(&cmdarg);
+            break;
+
         case '<':      /* a command result */
             if (!optonly)
                 replay_check_cmdresult(token);
@@ -1158,32 +1195,123 @@ out:
 }
 
 
+/* Move the data of the least recently used checkpoints (other than keep) to
+   the spill file until the rest fits into the budget.  Data that is in the
+   file already doesn't need to be written again, as it never changes. */
+static void
+spill_checkpoints(int keep)
+{
+    int i, lru;
+    struct replay_checkpoint *cp;
+
+    while (cp_budget && cp_memory > cp_budget) {
+        lru = -1;
+        for (i = 0; i < cpcount; i++)
+            if (i != keep && checkpoints[i].data &&
+                (lru < 0 ||
+                 checkpoints[i].lastuse < checkpoints[lru].lastuse))
+                lru = i;
+        if (lru < 0)
+            return;
+        cp = &checkpoints[lru];
+
+        if (cp->spillpos < 0) {
+            if (!spill_file && !(spill_file = tmpfile()))
+                return; /* keep everything in memory, then */
+            if (fseek(spill_file, 0, SEEK_END) != 0)
+                return;
+            cp->spillpos = ftell(spill_file);
+            if (fwrite(cp->data, 1, cp->datalen, spill_file) != cp->datalen) {
+                cp->spillpos = -1;
+                return;
+            }
+        }
+        free(cp->data);
+        cp->data = NULL;
+        cp_memory -= cp->datalen;
+    }
+}
+
+
+static void
+unspill_checkpoint(int idx)
+{
+    struct replay_checkpoint *cp = &checkpoints[idx];
+
+    cp->data = malloc(cp->datalen);
+    if (fseek(spill_file, cp->spillpos, SEEK_SET) != 0 ||
+        fread(cp->data, 1, cp->datalen, spill_file) != cp->datalen)
+        panic("Could not read back a replay checkpoint!");
+    cp_memory += cp->datalen;
+}
+
+
+/* the viewer went back; make checkpoints closer together from now on */
+static void
+checkpoint_seek_back(void)
+{
+    cp_forward = 0;
+    if (cp_interval > CHECKPOINT_MIN_INTERVAL)
+        cp_interval /= 2;
+}
+
+
 static void
 make_checkpoint(int actions)
 {
-    /* only make a checkpoint if enough actions have happened since the last
-       one and creating a checkpoint is safe */
-    if ((cpcount > 0 && (actions <= checkpoints[cpcount - 1].actions + 1000 ||
-                         true_moves() <= checkpoints[cpcount - 1].moves)) ||
+    struct replay_checkpoint *cp;
+    struct memfile mf;
+    int i;
+
+    /* only make a checkpoint if enough actions have happened since the
+       previous one, there are enough until the next one, and creating a
+       checkpoint is safe */
+    for (i = cpcount; i > 0 && checkpoints[i - 1].actions >= actions; i--)
+        ;
+    if ((i > 0 && (actions <= checkpoints[i - 1].actions + cp_interval ||
+                   true_moves() <= checkpoints[i - 1].moves)) ||
+        (i < cpcount && (actions + cp_interval >= checkpoints[i].actions ||
+                         true_moves() >= checkpoints[i].moves)) ||
         multi || occupation) /* checkpointing while something is in
                                 progress doesn't work */
         return;
 
     replay_sync_save();
 
+    if (i == cpcount && ++cp_forward >= 8 &&
+        cp_interval < CHECKPOINT_INTERVAL) {
+        cp_forward = 0;
+        cp_interval *= 2;
+    }
+
     cpcount++;
     checkpoints =
         realloc(checkpoints, sizeof (struct replay_checkpoint) * cpcount);
-    checkpoints[cpcount - 1].actions = actions;
-    checkpoints[cpcount - 1].moves = moves;
-    checkpoints[cpcount - 1].nexttoken = ftell(loginfo.flog);
+    memmove(&checkpoints[i + 1], &checkpoints[i],
+            sizeof (struct replay_checkpoint) * (cpcount - 1 - i));
+    cp = &checkpoints[i];
+    cp->actions = actions;
+    cp->moves = moves;
+    cp->nexttoken = ftell(loginfo.flog);
     /* the active option list must be saved: it is not part of the normal
        binary save */
-    checkpoints[cpcount - 1].opt = clone_optlist(options);
-    mnew(&checkpoints[cpcount - 1].cpdata, NULL);
-    savegame(&checkpoints[cpcount - 1].cpdata);
-    checkpoints[cpcount - 1].cpdata.len = checkpoints[cpcount - 1].cpdata.pos;
-    checkpoints[cpcount - 1].cpdata.pos = 0;
+    cp->opt = clone_optlist(options);
+
+    mnew(&mf, NULL);
+    savegame(&mf);
+    cp->rawlen = mf.pos;
+    cp->datalen = compressBound(cp->rawlen);
+    cp->data = malloc(cp->datalen);
+    if (compress2(cp->data, &cp->datalen, (unsigned char *)mf.buf,
+                  cp->rawlen, Z_BEST_SPEED) != Z_OK)
+        panic("Could not compress a replay checkpoint!");
+    cp->data = realloc(cp->data, cp->datalen);
+    mfree(&mf);
+
+    cp->spillpos = -1;
+    cp->lastuse = ++cp_clock;
+    cp_memory += cp->datalen;
+    spill_checkpoints(i);
 }
 
 
@@ -1193,9 +1321,18 @@ load_checkpoint(int idx)
     int playmode, i, irole, irace, igend, ialign;
     boolean cmd_invalid, diff_invalid;
     char namebuf[BUFSZ];
+    struct replay_checkpoint *cp;
+    struct memfile mf;
+    unsigned long rawlen;
 
     if (idx < 0 || idx >= cpcount)
         return -1;
+    cp = &checkpoints[idx];
+
+    if (!cp->data)
+        unspill_checkpoint(idx);
+    cp->lastuse = ++cp_clock;
+    spill_checkpoints(idx);
 
     cmd_invalid = loginfo.cmds_are_invalid;
     diff_invalid = loginfo.diffs_are_invalid;
@@ -1207,15 +1344,22 @@ load_checkpoint(int idx)
     replay_begin();
     replay_read_newgame(&turntime, &playmode, namebuf, &irole, &irace, &igend,
                         &ialign);
-    fseek(loginfo.flog, checkpoints[idx].nexttoken, SEEK_SET);
+    fseek(loginfo.flog, cp->nexttoken, SEEK_SET);
 
     loginfo.cmds_are_invalid = cmd_invalid;
     loginfo.diffs_are_invalid = diff_invalid;
 
     program_state.restoring = TRUE;
     startup_common(namebuf, playmode);
-    dorecover(&checkpoints[idx].cpdata);
-    checkpoints[idx].cpdata.pos = 0;
+
+    mnew(&mf, NULL);
+    mf.len = rawlen = cp->rawlen;
+    mf.buf = malloc(rawlen);
+    if (uncompress((unsigned char *)mf.buf, &rawlen, cp->data,
+                   cp->datalen) != Z_OK || rawlen != cp->rawlen)
+        panic("Could not decompress a replay checkpoint!");
+    dorecover(&mf);
+    mfree(&mf);
 
     mfree(&diff_base);
     mnew(&diff_base, NULL);
@@ -1225,13 +1369,12 @@ load_checkpoint(int idx)
     program_state.game_running = TRUE;
 
     /* restore the full option state of the time of the checkpoint */
-    for (i = 0; checkpoints[idx].opt[i].name; i++)
-        nh_set_option(checkpoints[idx].opt[i].name,
-                      checkpoints[idx].opt[i].value, FALSE);
+    for (i = 0; cp->opt[i].name; i++)
+        nh_set_option(cp->opt[i].name, cp->opt[i].value, FALSE);
 
     savegame(&diff_base);
 
-    return checkpoints[idx].actions;
+    return cp->actions;
 }
 
 
@@ -1242,11 +1385,19 @@ free_checkpoints(void)
 
     for (i = 0; i < cpcount; i++) {
         free_optlist(checkpoints[i].opt);
-        mfree(&(checkpoints[i].cpdata));
+        free(checkpoints[i].data);
     }
     free(checkpoints);
     checkpoints = NULL;
     cpcount = 0;
+
+    if (spill_file)
+        fclose(spill_file);
+    spill_file = NULL;
+    cp_memory = 0;
+    cp_clock = 0;
+    cp_interval = CHECKPOINT_INTERVAL;
+    cp_forward = 0;
 }
 
 
@@ -1294,6 +1445,7 @@ nh_view_replay_start(int fd, struct nh_window_procs * rwinprocs,
     program_state.restoring = TRUE;
     iflags.disable_log = TRUE;
     logfile = fd;
+    loginfo.desyncs = 0;
     replay_begin();
     replay_read_newgame(&turntime, &playmode, namebuf, &u.initrole, &u.initrace,
                         &u.initgend, &u.initalign);
@@ -1312,6 +1464,7 @@ nh_view_replay_start(int fd, struct nh_window_procs * rwinprocs,
 
     info->max_moves = gi.moves;
     info->max_actions = loginfo.actioncount - 1; /* - 1 for the new-game ~ */
+    info->desyncs = loginfo.desyncs;
     find_next_command(info->nextcmd, sizeof (info->nextcmd));
     update_inventory();
     make_checkpoint(0);
@@ -1345,6 +1498,7 @@ nh_view_replay_step(struct nh_replay_info * info, enum replay_control action,
             did_action = TRUE;
             goto out2;
         }
+        loginfo.desyncs++;
         count = moves_this_step;
         action = REPLAY_GOTO;
         moves = 0;
@@ -1359,6 +1513,7 @@ nh_view_replay_step(struct nh_replay_info * info, enum replay_control action,
     case REPLAY_BACKWARD:
         prev_actions = info->actions;
         target = prev_actions - count;
+        checkpoint_seek_back();
         for (i = 0; i < cpcount - 1; i++)
             if (checkpoints[i + 1].actions >= target)
                 break;
@@ -1388,6 +1543,7 @@ nh_view_replay_step(struct nh_replay_info * info, enum replay_control action,
     case REPLAY_GOTO:
         target = count;
         if (target < true_moves()) {
+            checkpoint_seek_back();
             for (i = 0; i < cpcount - 1; i++)
                 if (checkpoints[i + 1].moves >= target)
                     break;
@@ -1397,7 +1553,7 @@ nh_view_replay_step(struct nh_replay_info * info, enum replay_control action,
 
         did_action = info->actions < info->max_actions;
         while (true_moves() < count && did_action) {
-            did_action = replay_run_cmdloop(FALSE, TRUE, TRUE);
+            did_action = replay_run_cmdloop(FALSE, TRUE, !verify_goto);
             if (did_action) {
                 info->actions++;
                 make_checkpoint(info->actions);
@@ -1413,6 +1569,7 @@ out:
 out2:
     program_state.restoring = FALSE;
     info->moves = true_moves();
+    info->desyncs = loginfo.desyncs;
     find_next_command(info->nextcmd, sizeof (info->nextcmd));
     replay_restore_windowprocs();
     if (loginfo.cmds_are_invalid)
@@ -1429,6 +1586,27 @@ out2:
 }
 
 
+/* Make REPLAY_GOTO check each diff it passes against a fresh save of the
+   replayed game, as single steps do.  This is much slower, and is meant for
+   regression testing of replays (see util/replaybatch.c). */
+void
+nh_view_replay_verify(boolean verify)
+{
+    verify_goto = verify;
+}
+
+
+/* Limit the memory used by replay checkpoints to about this many bytes, or
+   don't limit it if bytes is 0.  Checkpoints beyond the limit are kept in a
+   temporary file. */
+void
+nh_view_replay_checkpoint_memory(unsigned long long bytes)
+{
+    cp_budget = bytes;
+    spill_checkpoints(-1);
+}
+
+
 void
 nh_view_replay_finish(void)
 {
@@ -1508,13 +1686,12 @@ nh_get_savegame_status(int fd, struct nh_game_info *gi)
 
     lseek(fd, savepos, SEEK_SET);
     if (ret == LS_SAVED) {
-        mf.pos = 0;
-        mf.buf = loadfile(fd, &mf.len);
-        if (!mf.buf)
+        /* only the version, flags, you and moves at the start are needed */
+        if (!mreadfd(&mf, fd, savegame_header_size()))
             return 0;
 
         if (!uptodate(&mf, NULL)) {
-            free(mf.buf);
+            mfree(&mf);
             api_exit();
             return LS_CRASHED;  /* probably still a valid game */
         }
@@ -1522,7 +1699,7 @@ nh_get_savegame_status(int fd, struct nh_game_info *gi)
         restore_flags(&mf, &sg_flags);
         restore_you(&mf, &sg_you);
         sg_moves = mread32(&mf);
-        free(mf.buf);
+        mfree(&mf);
 
         /* make sure topten_level_name can work correctly */
         if (!game_inited) {
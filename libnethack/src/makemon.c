@@ -62,7 +62,7 @@ newmonst(int extyp, int namelen)
         break;
     }
 
-    mon = malloc(sizeof (struct monst) + namelen + xlen);
+    mon = slab_alloc(sizeof (struct monst) + namelen + xlen);
     memset(mon, 0, sizeof (struct monst) + namelen + xlen);
     mon->mxtyp = extyp;
     mon->mxlth = xlen;
@@ -4,6 +4,10 @@
 
 #include "hack.h"
 
+#if defined(UNIX)
+# include <sys/mman.h>
+#endif
+
 #ifdef IS_BIG_ENDIAN
 static unsigned short
 host_to_le16(unsigned short x)
@@ -66,6 +70,8 @@ mnew(struct memfile *mf, struct memfile *relativeto)
     mf->curcmd = MDIFF_INVALID; /* no command yet */
     for (i = 0; i < MEMFILE_HASHTABLE_SIZE; i++)
         mf->tags[i] = 0;
+    mf->mapbase = NULL;
+    mf->maplen = 0;
 }
 
 void
@@ -73,8 +79,14 @@ mfree(struct memfile *mf)
 {
     int i;
 
-    free(mf->buf);
+#if defined(UNIX)
+    if (mf->mapbase)
+        munmap(mf->mapbase, mf->maplen);
+    else
+#endif
+        free(mf->buf);
     mf->buf = 0;
+    mf->mapbase = NULL;
     free(mf->diffbuf);
     mf->diffbuf = 0;
     for (i = 0; i < MEMFILE_HASHTABLE_SIZE; i++) {
@@ -89,6 +101,73 @@ mfree(struct memfile *mf)
     }
 }
 
+/* Reading memory files from disk. Both functions read from the current
+   position of fd and leave it at the end of what they read; they return FALSE
+   if there's nothing (or not enough) to read.
+
+   mmapfd maps the rest of the file into memory where possible, so that there
+   is no copy of the data and only the pages mread actually touches are loaded
+   from disk. The mapping is private, so writes to the memfile don't reach the
+   file. The file must not be truncated while the memfile exists. */
+boolean
+mmapfd(struct memfile *mf, int fd)
+{
+#if defined(UNIX)
+    off_t start, end, mapstart;
+    void *map;
+
+    mnew(mf, NULL);
+
+    start = lseek(fd, 0, SEEK_CUR);
+    end = lseek(fd, 0, SEEK_END);
+    if (start < 0 || end <= start)
+        return FALSE;
+
+    /* mappings have to start at a page boundary */
+    mapstart = start - start % sysconf(_SC_PAGESIZE);
+    map = mmap(NULL, end - mapstart, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+               mapstart);
+    if (map == MAP_FAILED) {
+        lseek(fd, start, SEEK_SET);
+        mf->buf = loadfile(fd, &mf->len);
+        return mf->buf != NULL;
+    }
+
+    mf->mapbase = map;
+    mf->maplen = end - mapstart;
+    mf->buf = (char *)map + (start - mapstart);
+    mf->len = end - start;
+    return TRUE;
+#else
+    mnew(mf, NULL);
+    mf->buf = loadfile(fd, &mf->len);
+    return mf->buf != NULL;
+#endif
+}
+
+/* mreadfd reads only the next len bytes. */
+boolean
+mreadfd(struct memfile *mf, int fd, int len)
+{
+    int ret, done = 0;
+
+    mnew(mf, NULL);
+    if (len <= 0)
+        return FALSE;
+
+    mf->buf = malloc(len);
+    mf->len = len;
+    while (done < len) {
+        ret = read(fd, mf->buf + done, len - done);
+        if (ret <= 0) {
+            mfree(mf);
+            return FALSE;
+        }
+        done += ret;
+    }
+    return TRUE;
+}
+
 /* Functions for writing to a memory file.
    There are two sorts of memory files: linear files, which work like
    ordinary filesystem files, and diff files, which are recorded
@@ -101,13 +180,24 @@ void
 mwrite(struct memfile *mf, const void *buf, unsigned int num)
 {
     boolean do_realloc = FALSE;
+    int oldlen = mf->len;
 
     while (mf->len < mf->pos + num) {
         mf->len += 4096;
         do_realloc = TRUE;
     }
 
-    if (do_realloc)
+    if (do_realloc && mf->mapbase) {
+        /* a mapped file can't grow; move it to the heap first */
+        char *copy = malloc(mf->len);
+
+        memcpy(copy, mf->buf, oldlen);
+#if defined(UNIX)
+        munmap(mf->mapbase, mf->maplen);
+#endif
+        mf->mapbase = NULL;
+        mf->buf = copy;
+    } else if (do_realloc)
         mf->buf = realloc(mf->buf, mf->len);
     memcpy(&mf->buf[mf->pos], buf, num);
 
@@ -325,7 +325,7 @@ mattackm(struct monst *magr, struct monst *mdef)
                 res[i] = hitmm(magr, mdef, mattk);
                 if ((mdef->data == &mons[PM_BLACK_PUDDING] ||
                      mdef->data == &mons[PM_BROWN_PUDDING])
-                    && otmp && objects[otmp->otyp].oc_material == IRON &&
+                    && otmp && objstate[otmp->otyp].oc_material == IRON &&
                     mdef->mhp > 1 && !mdef->mcan) {
                     if (clone_mon(mdef, 0, 0)) {
                         if (vis) {
@@ -812,8 +812,8 @@ u_slip_free(struct monst *mtmp, const struct attack *mattk)
               /* avoid "slippery slippery cloak" for undiscovered oilskin cloak 
                */
               (obj->greased ||
-               objects[obj->otyp].
-               oc_name_known) ? xname(obj) : cloak_simple_name(obj));
+               objstate[obj->otyp].oc_name_known) ? xname(obj) :
+              cloak_simple_name(obj));
 
         if (obj->greased && !rn2(2)) {
             pline("The grease wears off.");
@@ -954,7 +954,7 @@ hitmu(struct monst *mtmp, const struct attack *mattk)
                         goto do_stone;
                 }
                 dmg += dmgval(otmp, &youmonst);
-                if (objects[otmp->otyp].oc_material == SILVER &&
+                if (objstate[otmp->otyp].oc_material == SILVER &&
                     hates_silver(youmonst.data))
                     pline("The silver sears your flesh!");
 
@@ -967,7 +967,7 @@ hitmu(struct monst *mtmp, const struct attack *mattk)
                 if (!dmg)
                     break;
                 if (u.mh > 1 && u.mh > ((u.uac > 0) ? dmg : dmg + u.uac) &&
-                    objects[otmp->otyp].oc_material == IRON &&
+                    objstate[otmp->otyp].oc_material == IRON &&
                     (u.umonnum == PM_BLACK_PUDDING ||
                      u.umonnum == PM_BROWN_PUDDING)) {
                     /* This redundancy necessary because you have to take the
@@ -886,12 +886,13 @@ mklev(d_level * levnum)
     int ln = ledger_no(levnum);
     struct level *lev;
 
-    if (levels[ln])
-        return levels[ln];
+    if ((lev = level_by_ledger(ln)))
+        return lev;
 
     if (getbones(levnum))
         return levels[ln];      /* initialized in getbones->getlev */
 
+    bench_start(BENCH_LEVEL_CREATION);
     lev = levels[ln] = alloc_level(levnum);
 
     in_mklev = TRUE;
@@ -909,6 +910,7 @@ mklev(d_level * levnum)
             topologize(lev, croom);
     }
     set_wall_state(lev);
+    bench_stop(BENCH_LEVEL_CREATION);
 
     return lev;
 }
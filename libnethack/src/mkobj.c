@@ -10,9 +10,15 @@ static void obj_timer_checks(struct obj *, xchar, xchar, int);
 static void container_weight(struct obj *);
 static struct obj *save_mtraits(struct obj *, struct monst *);
 static void extract_nexthere(struct obj *, struct obj **);
+static int boxobj_compare(const void *, const void *);
 
 extern struct obj *thrownobj;   /* defined in dothrow.c */
 
+/* Incremented for every object placed on the floor; lev->objlist is always in
+   decreasing floorseq order, which lets range queries over lev->objects[][]
+   reproduce the objlist order without walking the whole chain. */
+static unsigned long floor_placements;
+
 /* #define DEBUG_EFFECTS *//* show some messages for debugging */
 
 struct icp {
@@ -108,10 +114,10 @@ mkobj(struct level *lev, char oclass, boolean artif)
     }
 
     i = bases[(int)oclass];
-    while ((prob -= objects[i].oc_prob) > 0)
+    while ((prob -= objstate[i].oc_prob) > 0)
         i++;
 
-    if (objects[i].oc_class != oclass || !OBJ_NAME(objects[i]))
+    if (objects[i].oc_class != oclass || !OBJ_NAME(i))
         panic("probtype error, oclass=%d i=%d", (int)oclass, i);
 
     return mksobj(lev, i, TRUE, artif);
@@ -300,6 +306,7 @@ replace_object(struct obj *obj, struct obj *otmp)
         otmp->nexthere = obj->nexthere;
         otmp->ox = obj->ox;
         otmp->oy = obj->oy;
+        otmp->floorseq = obj->floorseq;
         obj->nobj = otmp;
         obj->nexthere = otmp;
         extract_nobj(obj, &obj->olev->objlist);
@@ -1063,7 +1070,7 @@ boolean
 is_flammable(const struct obj * otmp)
 {
     int otyp = otmp->otyp;
-    int omat = objects[otyp].oc_material;
+    int omat = objstate[otyp].oc_material;
 
     if (objects[otyp].oc_oprop == FIRE_RES || otyp == WAN_FIRE)
         return FALSE;
@@ -1077,8 +1084,8 @@ is_rottable(const struct obj * otmp)
     int otyp = otmp->otyp;
 
     return ((boolean)
-            (objects[otyp].oc_material <= WOOD &&
-             objects[otyp].oc_material != LIQUID));
+            (objstate[otyp].oc_material <= WOOD &&
+             objstate[otyp].oc_material != LIQUID));
 }
 
 
@@ -1118,11 +1125,78 @@ place_object(struct obj *otmp, struct level *lev, int x, int y)
 
     /* add to floor chain */
     otmp->nobj = lev->objlist;
+    otmp->floorseq = ++floor_placements;
     lev->objlist = otmp;
     if (otmp->timed)
         obj_timer_checks(otmp, x, y, 0);
 }
 
+
+struct boxobj {
+    struct obj *obj;
+    int idx;
+};
+
+/* objlist order: newest placement first; objects sharing a floorseq (from
+   splitobj() or replace_object()) are adjacent in their pile in chain order */
+static int
+boxobj_compare(const void *vp1, const void *vp2)
+{
+    const struct boxobj *b1 = vp1, *b2 = vp2;
+
+    if (b1->obj->floorseq != b2->obj->floorseq)
+        return b1->obj->floorseq > b2->obj->floorseq ? -1 : 1;
+    return b1->idx - b2->idx;
+}
+
+/*
+ * Find the floor objects of lev within the box lx..hx, ly..hy (inclusive),
+ * using the per-square piles rather than scanning lev->objlist.  The objects
+ * are returned in a malloc'd array, which the caller must free, in exactly the
+ * order a walk over lev->objlist would visit them; AI code relies on this to
+ * keep its choices and RNG usage unchanged.  Returns the number found.
+ */
+int
+floor_objects_in_box(struct level *lev, int lx, int ly, int hx, int hy,
+                     struct obj ***objs_p)
+{
+    struct boxobj *found = NULL;
+    struct obj *otmp, **objs;
+    int x, y, i, n = 0, size = 0;
+
+    if (lx < 0)
+        lx = 0;
+    if (ly < 0)
+        ly = 0;
+    if (hx >= COLNO)
+        hx = COLNO - 1;
+    if (hy >= ROWNO)
+        hy = ROWNO - 1;
+
+    for (x = lx; x <= hx; x++)
+        for (y = ly; y <= hy; y++)
+            for (otmp = lev->objects[x][y]; otmp; otmp = otmp->nexthere) {
+                if (n == size) {
+                    size = size ? size * 2 : 32;
+                    found = realloc(found, size * sizeof (struct boxobj));
+                }
+                found[n].obj = otmp;
+                found[n].idx = n;
+                n++;
+            }
+
+    if (n > 1)
+        qsort(found, n, sizeof (struct boxobj), boxobj_compare);
+
+    objs = malloc((n ? n : 1) * sizeof (struct obj *));
+    for (i = 0; i < n; i++)
+        objs[i] = found[i].obj;
+    free(found);
+
+    *objs_p = objs;
+    return n;
+}
+
 #define ON_ICE(a) ((a)->recharged)
 #define ROT_ICE_ADJUSTMENT 2    /* rotting on ice takes 2 times as long */
 
@@ -1462,7 +1536,7 @@ dealloc_obj(struct obj *obj)
     if (obj == thrownobj)
         thrownobj = NULL;
 
-    free(obj);
+    slab_free(obj);
 }
 
 
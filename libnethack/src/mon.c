@@ -820,7 +820,7 @@ mpickgold(struct monst *mtmp)
     int mat_idx;
 
     if ((gold = gold_at(level, mtmp->mx, mtmp->my)) != 0) {
-        mat_idx = objects[gold->otyp].oc_material;
+        mat_idx = objstate[gold->otyp].oc_material;
         obj_extract_self(gold);
         add_to_minv(mtmp, gold);
         if (cansee(mtmp->mx, mtmp->my)) {
@@ -937,7 +937,7 @@ can_carry(struct monst *mtmp, struct obj *otmp)
         return FALSE;
     if (otyp == CORPSE && is_rider(&mons[otmp->corpsenm]))
         return FALSE;
-    if (objects[otyp].oc_material == SILVER && hates_silver(mdat) &&
+    if (objstate[otyp].oc_material == SILVER && hates_silver(mdat) &&
         (otyp != BELL_OF_OPENING || !is_covetous(mdat)))
         return FALSE;
 
@@ -1329,7 +1329,7 @@ relmon(struct monst *mon)
     if (mon->dlevel->monlist == NULL)
         panic("relmon: no level->monlist available.");
 
-    mon->dlevel->monsters[mon->mx][mon->my] = NULL;
+    remove_monster(mon->dlevel, mon->mx, mon->my);
 
     if (mon == mon->dlevel->monlist)
         mon->dlevel->monlist = mon->dlevel->monlist->nmon;
@@ -1353,7 +1353,7 @@ m_detach(struct monst *mtmp, const struct permonst *mptr)
     mtmp->mtrapped = 0;
     mtmp->mhp = 0;      /* simplify some tests: force mhp to 0 */
     relobj(mtmp, 0, FALSE);
-    mtmp->dlevel->monsters[mtmp->mx][mtmp->my] = NULL;
+    remove_monster(mtmp->dlevel, mtmp->mx, mtmp->my);
     if (emits_light(mptr))
         del_light_source(mtmp->dlevel, LS_MONSTER, mtmp);
     newsym(mtmp->mx, mtmp->my);
@@ -2781,7 +2781,8 @@ mimic_hit_msg(struct monst *mtmp, short otyp)
     case M_AP_OBJECT:
         if (otyp == SPE_HEALING || otyp == SPE_EXTRA_HEALING) {
             pline("%s seems a more vivid %s than before.",
-                  The(simple_typename(ap)), c_obj_colors[objects[ap].oc_color]);
+                  The(simple_typename(ap)),
+                  c_obj_colors[objstate[ap].oc_color]);
         }
         break;
     }
@@ -197,7 +197,7 @@ can_blnd(struct monst * magr,   /* NULL == no specific aggressor */
         o = (mdef == &youmonst) ? invent : mdef->minvent;
         for (; o; o = o->nobj)
             if ((o->owornmask & W_ARMH) &&
-                (s = OBJ_DESCR(objects[o->otyp])) != NULL &&
+                (s = OBJ_DESCR(o->otyp)) != NULL &&
                 !strcmp(s, "visored helmet"))
                 return FALSE;
     }
@@ -768,8 +768,8 @@ not_special:
 
     {
         int minr = SQSRCHRADIUS;        /* not too far away */
-        struct obj *otmp;
-        int xx, yy;
+        struct obj *otmp, **objs;
+        int xx, yy, oidx, nobjs;
         int oomx, oomy, lmx, lmy;
 
         /* cut down the search radius if it thinks character is closer. */
@@ -789,7 +789,9 @@ not_special:
             oomy = min(ROWNO - 1, omy + minr);
             lmx = max(1, omx - minr);
             lmy = max(0, omy - minr);
-            for (otmp = level->objlist; otmp; otmp = otmp->nobj) {
+            nobjs = floor_objects_in_box(level, lmx, lmy, oomx, oomy, &objs);
+            for (oidx = 0; oidx < nobjs; oidx++) {
+                otmp = objs[oidx];
                 /* monsters may pick rocks up, but won't go out of their way to 
                    grab them; this might hamper sling wielders, but it cuts
                    down on move overhead by filtering out most common item */
@@ -820,7 +822,7 @@ not_special:
                          (uses_items && searches_for_item(mtmp, otmp)) ||
                          (likerock && otmp->otyp == BOULDER) ||
                          (likegems && otmp->oclass == GEM_CLASS &&
-                          objects[otmp-> otyp].oc_material != MINERAL) ||
+                          objstate[otmp-> otyp].oc_material != MINERAL) ||
                          (conceals && !cansee(otmp->ox, otmp->oy)) ||
                          (ptr == &mons[PM_GELATINOUS_CUBE] &&
                           !strchr(indigestion, otmp->oclass) &&
@@ -831,7 +833,7 @@ not_special:
                             (throws_rocks(ptr) ||
                              !sobj_at(BOULDER, level, xx, yy)) &&
                             (!is_unicorn(ptr) ||
-                             objects[otmp->otyp].oc_material == GEMSTONE) &&
+                             objstate[otmp->otyp].oc_material == GEMSTONE) &&
                             /* Don't get stuck circling an Elbereth */
                             !(onscary(xx, yy, mtmp))) {
                             minr = distmin(omx, omy, xx, yy);
@@ -843,12 +845,14 @@ not_special:
                             gy = otmp->oy;
                             if (gx == omx && gy == omy) {
                                 mmoved = 3;     /* actually unnecessary */
+                                free(objs);
                                 goto postmov;
                             }
                         }
                     }
                 }
             }
+            free(objs);
         } else if (likegold) {
             /* don't try to pick up anything else, but use the same loop */
             uses_items = 0;
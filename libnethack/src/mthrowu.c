@@ -74,7 +74,7 @@ thitu(int tlev, int dam, struct obj *obj, const char *name)
         else
             pline("You are hit by %s%s", onm, exclam(dam));
 
-        if (obj && objects[obj->otyp].oc_material == SILVER &&
+        if (obj && objstate[obj->otyp].oc_material == SILVER &&
             hates_silver(youmonst.data)) {
             dam += rnd(20);
             pline("The silver sears your flesh!");
@@ -207,7 +207,7 @@ int ohitmon(struct monst *mtmp, /* accidental target */
                 }
             }
         }
-        if (objects[otmp->otyp].oc_material == SILVER &&
+        if (objstate[otmp->otyp].oc_material == SILVER &&
             hates_silver(mtmp->data)) {
             if (vis)
                 pline("The silver sears %s flesh!", s_suffix(mon_nam(mtmp)));
@@ -1179,8 +1179,8 @@ hits_bars(struct obj ** obj_p,  /* *obj_p will be set to NULL if object breaks *
         else if (obj_type == BOULDER || obj_type == HEAVY_IRON_BALL)
             pline("Whang!");
         else if (otmp->oclass == COIN_CLASS ||
-                 objects[obj_type].oc_material == GOLD ||
-                 objects[obj_type].oc_material == SILVER)
+                 objstate[obj_type].oc_material == GOLD ||
+                 objstate[obj_type].oc_material == SILVER)
             pline("Clink!");
         else
             pline("Clonk!");
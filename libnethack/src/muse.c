@@ -58,7 +58,7 @@ precheck(struct monst *mon, struct obj *obj, struct musable *m)
 
 #define POTION_OCCUPANT_CHANCE(n) (13 + 2*(n))  /* also in potion.c */
 
-        potion_descr = OBJ_DESCR(objects[obj->otyp]);
+        potion_descr = OBJ_DESCR(obj->otyp);
         if (potion_descr && !strcmp(potion_descr, "milky")) {
             if (flags.ghost_count < MAXMONNO &&
                 !rn2(POTION_OCCUPANT_CHANCE(flags.ghost_count))) {
@@ -709,8 +709,8 @@ use_defensive(struct monst *mtmp, struct musable *m)
                teleported. */
             if (known)
                 makeknown(SCR_CREATE_MONSTER);
-            else if (!objects[SCR_CREATE_MONSTER].oc_name_known &&
-                     !objects[SCR_CREATE_MONSTER].oc_uname)
+            else if (!objstate[SCR_CREATE_MONSTER].oc_name_known &&
+                     !objstate[SCR_CREATE_MONSTER].oc_uname)
                 docall(otmp);
             m_useup(mtmp, otmp);
             return 2;
@@ -1678,8 +1678,8 @@ use_misc(struct monst *mtmp, struct musable *m)
                 if (vismon) {
                     pline("%s rises up, through the %s!", Monnam(mtmp),
                           ceiling(mtmp->mx, mtmp->my));
-                    if (!objects[POT_GAIN_LEVEL].oc_name_known &&
-                        !objects[POT_GAIN_LEVEL].oc_uname)
+                    if (!objstate[POT_GAIN_LEVEL].oc_name_known &&
+                        !objstate[POT_GAIN_LEVEL].oc_uname)
                         docall(otmp);
                 }
                 m_useup(mtmp, otmp);
@@ -1689,8 +1689,8 @@ use_misc(struct monst *mtmp, struct musable *m)
             skipmsg:
                 if (vismon) {
                     pline("%s looks uneasy.", Monnam(mtmp));
-                    if (!objects[POT_GAIN_LEVEL].oc_name_known &&
-                        !objects[POT_GAIN_LEVEL].oc_uname)
+                    if (!objstate[POT_GAIN_LEVEL].oc_name_known &&
+                        !objstate[POT_GAIN_LEVEL].oc_uname)
                         docall(otmp);
                 }
                 m_useup(mtmp, otmp);
@@ -1815,7 +1815,7 @@ use_misc(struct monst *mtmp, struct musable *m)
                 pline("The whip slips free.");  /* not `The_whip' */
                 return 1;
             } else if (where_to == 3 && hates_silver(mtmp->data) &&
-                       objects[obj->otyp].oc_material == SILVER) {
+                       objstate[obj->otyp].oc_material == SILVER) {
                 /* this monster won't want to catch a silver weapon; drop it at 
                    hero's feet instead */
                 where_to = 2;
@@ -1848,8 +1848,8 @@ use_misc(struct monst *mtmp, struct musable *m)
                 pline("You feel as though %s needs some help.", mon_nam(mtmp));
             else
                 pline("You feel like someone is helping %s.", mon_nam(mtmp));
-            if (!objects[SCR_REMOVE_CURSE].oc_name_known &&
-                !objects[SCR_REMOVE_CURSE].oc_uname)
+            if (!objstate[SCR_REMOVE_CURSE].oc_name_known &&
+                !objstate[SCR_REMOVE_CURSE].oc_uname)
                 docall(otmp);
         }
         {
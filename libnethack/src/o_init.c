@@ -24,15 +24,15 @@ setgemprobs(const d_level * dlev)
     first = bases[GEM_CLASS];
 
     for (j = 0; j < 9 - lev / 3; j++)
-        objects[first + j].oc_prob = 0;
+        objstate[first + j].oc_prob = 0;
     first += j;
     if (first > LAST_GEM || objects[first].oc_class != GEM_CLASS ||
-        OBJ_NAME(objects[first]) == NULL) {
+        OBJ_NAME(first) == NULL) {
         raw_printf("Not enough gems? - first=%d j=%d LAST_GEM=%d\n", first, j,
                    LAST_GEM);
     }
     for (j = first; j <= LAST_GEM; j++)
-        objects[j].oc_prob = (171 + j - first) / (LAST_GEM + 1 - first);
+        objstate[j].oc_prob = (171 + j - first) / (LAST_GEM + 1 - first);
 }
 
 /* shuffle descriptions on objects o_low to o_high */
@@ -44,32 +44,32 @@ shuffle(int o_low, int o_high, boolean domaterial)
     int color;
 
     for (num_to_shuffle = 0, j = o_low; j <= o_high; j++)
-        if (!objects[j].oc_name_known)
+        if (!objstate[j].oc_name_known)
             num_to_shuffle++;
     if (num_to_shuffle < 2)
         return;
 
     for (j = o_low; j <= o_high; j++) {
-        if (objects[j].oc_name_known)
+        if (objstate[j].oc_name_known)
             continue;
         do
             i = j + rn2(o_high - j + 1);
-        while (objects[i].oc_name_known);
-        sw = objects[j].oc_descr_idx;
-        objects[j].oc_descr_idx = objects[i].oc_descr_idx;
-        objects[i].oc_descr_idx = sw;
-        sw = objects[j].oc_tough;
-        objects[j].oc_tough = objects[i].oc_tough;
-        objects[i].oc_tough = sw;
-        color = objects[j].oc_color;
-        objects[j].oc_color = objects[i].oc_color;
-        objects[i].oc_color = color;
+        while (objstate[i].oc_name_known);
+        sw = objstate[j].oc_descr_idx;
+        objstate[j].oc_descr_idx = objstate[i].oc_descr_idx;
+        objstate[i].oc_descr_idx = sw;
+        sw = objstate[j].oc_tough;
+        objstate[j].oc_tough = objstate[i].oc_tough;
+        objstate[i].oc_tough = sw;
+        color = objstate[j].oc_color;
+        objstate[j].oc_color = objstate[i].oc_color;
+        objstate[i].oc_color = color;
 
         /* shuffle material */
         if (domaterial) {
-            sw = objects[j].oc_material;
-            objects[j].oc_material = objects[i].oc_material;
-            objects[i].oc_material = sw;
+            sw = objstate[j].oc_material;
+            objstate[j].oc_material = objstate[i].oc_material;
+            objstate[i].oc_material = sw;
         }
     }
 }
@@ -91,7 +91,7 @@ init_objects(void)
         bases[i] = 0;
     /* initialize object descriptions */
     for (i = 0; i < NUM_OBJECTS; i++)
-        objects[i].oc_name_idx = objects[i].oc_descr_idx = i;
+        objstate[i].oc_descr_idx = i;
     /* init base; if probs given check that they add up to 1000, otherwise
        compute probs */
     first = 0;
@@ -106,32 +106,32 @@ init_objects(void)
             setgemprobs(NULL);
 
             if (rn2(2)) {       /* change turquoise from green to blue? */
-                COPY_OBJ_DESCR(objects[TURQUOISE], objects[SAPPHIRE]);
+                COPY_OBJ_DESCR(objstate[TURQUOISE], objstate[SAPPHIRE]);
             }
             if (rn2(2)) {       /* change aquamarine from green to blue? */
-                COPY_OBJ_DESCR(objects[AQUAMARINE], objects[SAPPHIRE]);
+                COPY_OBJ_DESCR(objstate[AQUAMARINE], objstate[SAPPHIRE]);
             }
             switch (rn2(4)) {   /* change fluorite from violet? */
             case 0:
                 break;
             case 1:    /* blue */
-                COPY_OBJ_DESCR(objects[FLUORITE], objects[SAPPHIRE]);
+                COPY_OBJ_DESCR(objstate[FLUORITE], objstate[SAPPHIRE]);
                 break;
             case 2:    /* white */
-                COPY_OBJ_DESCR(objects[FLUORITE], objects[DIAMOND]);
+                COPY_OBJ_DESCR(objstate[FLUORITE], objstate[DIAMOND]);
                 break;
             case 3:    /* green */
-                COPY_OBJ_DESCR(objects[FLUORITE], objects[EMERALD]);
+                COPY_OBJ_DESCR(objstate[FLUORITE], objstate[EMERALD]);
                 break;
             }
         }
     check:
         sum = 0;
         for (i = first; i < last; i++)
-            sum += objects[i].oc_prob;
+            sum += objstate[i].oc_prob;
         if (sum == 0) {
             for (i = first; i < last; i++)
-                objects[i].oc_prob = (1000 + i - first) / (last - first);
+                objstate[i].oc_prob = (1000 + i - first) / (last - first);
             goto check;
         }
         if (sum != 1000)
@@ -154,7 +154,7 @@ shuffle_all(void)
         while (last < NUM_OBJECTS && objects[last].oc_class == oclass)
             last++;
 
-        if (OBJ_DESCR(objects[first]) != NULL && oclass != TOOL_CLASS &&
+        if (OBJ_DESCR(first) != NULL && oclass != TOOL_CLASS &&
             oclass != WEAPON_CLASS && oclass != ARMOR_CLASS &&
             oclass != GEM_CLASS) {
             int j = last - 1;
@@ -196,7 +196,7 @@ find_skates(void)
     const char *s;
 
     for (i = SPEED_BOOTS; i <= LEVITATION_BOOTS; i++)
-        if ((s = OBJ_DESCR(objects[i])) != 0 && !strcmp(s, "snow boots"))
+        if ((s = OBJ_DESCR(i)) != 0 && !strcmp(s, "snow boots"))
             return i;
 
     impossible("snow boots not found?");
@@ -210,27 +210,31 @@ oinit(const struct level *lev)
 }
 
 
+/* The fixed properties of an object class are saved too, although restoring
+   only needs its objstate. */
 static void
-saveobjclass(struct memfile *mf, struct objclass *ocl)
+saveobjclass(struct memfile *mf, int otyp)
 {
+    const struct objclass *ocl = &objects[otyp];
+    const struct objstate *ost = &objstate[otyp];
     int namelen = 0;
     unsigned int oflags;
 
     /* no mtag useful; object classes are always saved in the same order and
        there are always the same number of them */
     oflags =
-        (ocl->oc_name_known << 31) | (ocl->oc_merge << 30) |
-        (ocl->oc_uses_known << 29) | (ocl->oc_pre_discovered << 28) |
+        ((unsigned int)ost->oc_name_known << 31) | (ocl->oc_merge << 30) |
+        (ocl->oc_uses_known << 29) | (ost->oc_pre_discovered << 28) |
         (ocl->oc_magic << 27) | (ocl->oc_charged << 26) |
         (ocl->oc_unique << 25) | (ocl->oc_nowish << 24) |
-        (ocl->oc_big << 23) | (ocl->oc_tough << 22) |
-        (ocl->oc_dir << 20) | (ocl->oc_material << 15) |
-        (ocl->oc_disclose_id << 14);
+        (ocl->oc_big << 23) | (ost->oc_tough << 22) |
+        (ocl->oc_dir << 20) | (ost->oc_material << 15) |
+        (ost->oc_disclose_id << 14);
     mwrite32(mf, oflags);
-    mwrite16(mf, ocl->oc_name_idx);
-    mwrite16(mf, ocl->oc_descr_idx);
+    mwrite16(mf, otyp); /* the index of the name */
+    mwrite16(mf, ost->oc_descr_idx);
     mwrite16(mf, ocl->oc_weight);
-    mwrite16(mf, ocl->oc_prob);
+    mwrite16(mf, ost->oc_prob);
     mwrite16(mf, ocl->oc_cost);
     mwrite16(mf, ocl->oc_nutrition);
 
@@ -238,7 +242,7 @@ saveobjclass(struct memfile *mf, struct objclass *ocl)
     mwrite8(mf, ocl->oc_oprop);
     mwrite8(mf, ocl->oc_class);
     mwrite8(mf, ocl->oc_delay);
-    mwrite8(mf, ocl->oc_color);
+    mwrite8(mf, ost->oc_color);
     mwrite8(mf, ocl->oc_wsdam);
     mwrite8(mf, ocl->oc_wldam);
     mwrite8(mf, ocl->oc_oc1);
@@ -246,10 +250,10 @@ saveobjclass(struct memfile *mf, struct objclass *ocl)
 
     /* as long as we use only one version of Hack we need not save oc_name and
        oc_descr, but we must save oc_uname for all objects */
-    namelen = ocl->oc_uname ? strlen(ocl->oc_uname) + 1 : 0;
+    namelen = ost->oc_uname ? strlen(ost->oc_uname) + 1 : 0;
     mwrite32(mf, namelen);
     if (namelen)
-        mwrite(mf, ocl->oc_uname, namelen);
+        mwrite(mf, ost->oc_uname, namelen);
 }
 
 
@@ -267,7 +271,7 @@ savenames(struct memfile *mf)
         mwrite32(mf, disco[i]);
 
     for (i = 0; i < NUM_OBJECTS; i++)
-        saveobjclass(mf, &objects[i]);
+        saveobjclass(mf, i);
 }
 
 
@@ -277,56 +281,42 @@ freenames(void)
     int i;
 
     for (i = 0; i < NUM_OBJECTS; i++)
-        if (objects[i].oc_uname) {
-            free(objects[i].oc_uname);
-            objects[i].oc_uname = NULL;
+        if (objstate[i].oc_uname) {
+            free(objstate[i].oc_uname);
+            objstate[i].oc_uname = NULL;
         }
 }
 
 
 static void
-restobjclass(struct memfile *mf, struct objclass *ocl)
+restobjclass(struct memfile *mf, struct objstate *ost)
 {
     int namelen;
     unsigned int oflags;
 
     oflags = mread32(mf);
-    ocl->oc_name_known = (oflags >> 31) & 1;
-    ocl->oc_merge = (oflags >> 30) & 1;
-    ocl->oc_uses_known = (oflags >> 29) & 1;
-    ocl->oc_pre_discovered = (oflags >> 28) & 1;
-    ocl->oc_magic = (oflags >> 27) & 1;
-    ocl->oc_charged = (oflags >> 26) & 1;
-    ocl->oc_unique = (oflags >> 25) & 1;
-    ocl->oc_nowish = (oflags >> 24) & 1;
-    ocl->oc_big = (oflags >> 23) & 1;
-    ocl->oc_tough = (oflags >> 22) & 1;
-    ocl->oc_dir = (oflags >> 20) & 3;
-    ocl->oc_material = (oflags >> 15) & 31;
-    ocl->oc_disclose_id = (oflags >> 14) & 1;
-
-    ocl->oc_name_idx = mread16(mf);
-    ocl->oc_descr_idx = mread16(mf);
-    ocl->oc_weight = mread16(mf);
-    ocl->oc_prob = mread16(mf);
-    ocl->oc_cost = mread16(mf);
-    ocl->oc_nutrition = mread16(mf);
-
-    ocl->oc_subtyp = mread8(mf);
-    ocl->oc_oprop = mread8(mf);
-    ocl->oc_class = mread8(mf);
-    ocl->oc_delay = mread8(mf);
-    ocl->oc_color = mread8(mf);
-    ocl->oc_wsdam = mread8(mf);
-    ocl->oc_wldam = mread8(mf);
-    ocl->oc_oc1 = mread8(mf);
-    ocl->oc_oc2 = mread8(mf);
-
-    ocl->oc_uname = NULL;
+    ost->oc_name_known = (oflags >> 31) & 1;
+    ost->oc_pre_discovered = (oflags >> 28) & 1;
+    ost->oc_tough = (oflags >> 22) & 1;
+    ost->oc_material = (oflags >> 15) & 31;
+    ost->oc_disclose_id = (oflags >> 14) & 1;
+
+    mread16(mf);        /* name index */
+    ost->oc_descr_idx = mread16(mf);
+    mread16(mf);        /* weight */
+    ost->oc_prob = mread16(mf);
+    mread16(mf);        /* cost */
+    mread16(mf);        /* nutrition */
+
+    mread32(mf);        /* subtype, property, class and delay */
+    ost->oc_color = mread8(mf);
+    mread32(mf);        /* damage and the two misc values */
+
+    ost->oc_uname = NULL;
     namelen = mread32(mf);
     if (namelen) {
-        ocl->oc_uname = malloc(namelen);
-        mread(mf, ocl->oc_uname, namelen);
+        ost->oc_uname = malloc(namelen);
+        mread(mf, ost->oc_uname, namelen);
     }
 
 }
@@ -346,7 +336,7 @@ restnames(struct memfile *mf)
         disco[i] = mread32(mf);
 
     for (i = 0; i < NUM_OBJECTS; i++)
-        restobjclass(mf, &objects[i]);
+        restobjclass(mf, &objstate[i]);
 }
 
 
@@ -354,7 +344,7 @@ void
 discover_object(int oindx, boolean mark_as_known, boolean credit_hero,
                 boolean disclose_only)
 {
-    if (!objects[oindx].oc_name_known) {
+    if (!objstate[oindx].oc_name_known) {
         int dindx, acls = objects[oindx].oc_class;
 
         /* Loop thru disco[] 'til we find the target (which may have been
@@ -366,9 +356,9 @@ discover_object(int oindx, boolean mark_as_known, boolean credit_hero,
         disco[dindx] = oindx;
 
         if (mark_as_known) {
-            objects[oindx].oc_name_known = 1;
+            objstate[oindx].oc_name_known = 1;
             if (disclose_only)
-                objects[oindx].oc_disclose_id = 1;
+                objstate[oindx].oc_disclose_id = 1;
             if (credit_hero)
                 exercise(A_WIS, TRUE);
         }
@@ -381,7 +371,7 @@ discover_object(int oindx, boolean mark_as_known, boolean credit_hero,
 void
 undiscover_object(int oindx)
 {
-    if (!objects[oindx].oc_name_known) {
+    if (!objstate[oindx].oc_name_known) {
         int dindx, acls = objects[oindx].oc_class;
         boolean found = FALSE;
 
@@ -408,8 +398,8 @@ interesting_to_discover(int i)
 {
     /* Pre-discovered objects are now printed with a '*' */
     return ((boolean)
-            (objects[i].oc_uname != NULL ||
-             (objects[i].oc_name_known && OBJ_DESCR(objects[i]) != NULL)));
+            (objstate[i].oc_uname != NULL ||
+             (objstate[i].oc_name_known && OBJ_DESCR(i) != NULL)));
 }
 
 /* items that should stand out once they're known */
@@ -436,10 +426,10 @@ dodiscovered(void)
     /* gather "unique objects" into a pseudo-class; note that they'll also be
        displayed individually within their regular class */
     for (i = dis = 0; i < SIZE(uniq_objs); i++)
-        if (objects[uniq_objs[i]].oc_name_known) {
+        if (objstate[uniq_objs[i]].oc_name_known) {
             if (!dis++)
                 add_menuheading(&menu, "Unique Items");
-            sprintf(buf, "  %s", OBJ_NAME(objects[uniq_objs[i]]));
+            sprintf(buf, "  %s", OBJ_NAME(uniq_objs[i]));
             add_menutext(&menu, buf);
             ++ct;
         }
@@ -466,7 +456,7 @@ dodiscovered(void)
                     prev_class = oclass;
                 }
                 sprintf(buf, "%s %s",
-                        (objects[dis].oc_pre_discovered ? "*" : " "),
+                        (objstate[dis].oc_pre_discovered ? "*" : " "),
                         obj_typename(dis));
                 add_menutext(&menu, buf);
             }
@@ -493,14 +483,14 @@ count_discovered_objects(int *curp, int *maxp)
     *maxp = 0;
     *curp = 0;
     for (i = 0; i < NUM_OBJECTS; i++) {
-        if (objects[i].oc_pre_discovered)
+        if (objstate[i].oc_pre_discovered)
             continue;
-        if (OBJ_DESCR(objects[i]) == (char *)0)
+        if (OBJ_DESCR(i) == (char *)0)
             continue;
         (*maxp)++;
-        if (!objects[i].oc_name_known)
+        if (!objstate[i].oc_name_known)
             continue;
-        if (objects[i].oc_disclose_id)
+        if (objstate[i].oc_disclose_id)
             continue;   /* identified in DYWYPI */
         (*curp)++;
     }
@@ -14,8 +14,8 @@ struct monst {
 # include "prop.h"
 # include "skills.h"
 
-#else /* !OBJECTS_PASS_2_ */
-/* second pass */
+#elif !defined(OBJECTS_PASS_3_)
+/* second and third pass */
 # include "color.h"
 # define COLOR_FIELD(X) X,
 #endif /* !OBJECTS_PASS_2_ */
@@ -27,8 +27,14 @@ struct monst {
  * Note:  OBJ() and BITS() macros are used to avoid exceeding argument
  * limits imposed by some compilers.  The ctnr field of BITS currently
  * does not map into struct objclass, and is ignored in the expansion.
- * The 0 in the expansion corresponds to oc_pre_discovered, which is
- * set at run-time during role-specific character initialization.
+ *
+ * The table is compiled three times: names and descriptions go into
+ * obj_descr[], the fixed properties into objects[], and the properties that
+ * change during a game into const_objstate[], which is copied into objstate[]
+ * at the start of each game.  That way everything but objstate[] is shared by
+ * all the games a process plays.  The first 0 in the third expansion is
+ * oc_pre_discovered, which is set at run-time during role-specific character
+ * initialization.
  */
 
 #ifndef OBJECTS_PASS_2_
@@ -38,19 +44,25 @@ struct monst {
              {obj}
 
 const struct objdescr obj_descr[] = {
-#else
+#elif !defined(OBJECTS_PASS_3_)
 /* second pass -- object definitions */
 
 # define BITS(nmkn,mrg,uskn,ctnr,mgc,chrg,uniq,nwsh,big,tuf,dir,sub,mtrl) \
-        nmkn,mrg,uskn,0,mgc,chrg,uniq,nwsh,0,big,tuf,dir,mtrl,sub
+        mrg,uskn,mgc,chrg,uniq,nwsh,big,dir,sub
 # define OBJECT(obj,bits,prp,sym,prob,dly,wt,cost,sdam,ldam,oc1,oc2,nut,color) \
-        {0, 0, NULL, bits, prp, sym, dly, COLOR_FIELD(color) \
-         prob, wt, cost, sdam, ldam, oc1, oc2, nut}
+        {bits, prp, sym, dly, wt, cost, sdam, ldam, oc1, oc2, nut}
 # define HARDGEM(n) (n >= 8)
 
-struct objclass *objects;
+const struct objclass objects[] = {
+#else
+/* third pass -- initial state of each object class in a game */
+
+# define BITS(nmkn,mrg,uskn,ctnr,mgc,chrg,uniq,nwsh,big,tuf,dir,sub,mtrl) \
+        nmkn,0,0,tuf,mtrl
+# define OBJECT(obj,bits,prp,sym,prob,dly,wt,cost,sdam,ldam,oc1,oc2,nut,color) \
+        {NULL, 0, prob, bits, COLOR_FIELD(color)}
 
-const struct objclass const_objects[] = {
+const struct objstate const_objstate[] = {
 #endif
 /* dummy object[0] -- description [2nd arg] *must* be NULL */
     OBJECT(OBJ("strange object", NULL),
@@ -1011,13 +1023,24 @@ const struct objclass const_objects[] = {
 # define OBJECTS_PASS_2_
 # include "objects.c"
 
+#elif !defined(OBJECTS_PASS_3_)
+
+/* and for the third one */
+# undef BITS
+# undef OBJECT
+# define OBJECTS_PASS_3_
+# include "objects.c"
+
 #else
 
+struct objstate objstate[SIZE(const_objstate)];
+boolean objstate_valid;
+
 void
 init_objlist(void)
 {
-    objects = malloc(sizeof (const_objects));
-    memcpy(objects, const_objects, sizeof (const_objects));
+    memcpy(objstate, const_objstate, sizeof (const_objstate));
+    objstate_valid = TRUE;
 }
 
 #endif /* !OBJECTS_PASS_2_ */
@@ -82,7 +82,7 @@ struct Jitem {
 
 /* true for gems/rocks that should have " stone" appended to their names */
 #define GemStone(typ)   (typ == FLINT ||                                \
-                         (objects[typ].oc_material == GEMSTONE &&       \
+                         (objstate[typ].oc_material == GEMSTONE &&       \
                           (typ != DILITHIUM_CRYSTAL && typ != RUBY &&   \
                            typ != DIAMOND && typ != SAPPHIRE &&         \
                            typ != BLACK_OPAL &&         \
@@ -138,11 +138,12 @@ char *
 obj_typename(int otyp)
 {
     char *buf = nextobuf();
-    struct objclass *ocl = &objects[otyp];
-    const char *actualn = OBJ_NAME(*ocl);
-    const char *dn = OBJ_DESCR(*ocl);
-    const char *un = ocl->oc_uname;
-    int nn = ocl->oc_name_known;
+    const struct objclass *ocl = &objects[otyp];
+    const struct objstate *ost = &objstate[otyp];
+    const char *actualn = OBJ_NAME(otyp);
+    const char *dn = OBJ_DESCR(otyp);
+    const char *un = ost->oc_uname;
+    int nn = ost->oc_name_known;
 
     if (Role_if(PM_SAMURAI) && Japanese_item_name(otyp))
         actualn = Japanese_item_name(otyp);
@@ -187,7 +188,7 @@ obj_typename(int otyp)
         } else {
             strcpy(buf, dn ? dn : actualn);
             if (ocl->oc_class == GEM_CLASS)
-                strcat(buf, (ocl->oc_material == MINERAL) ? " stone" : " gem");
+                strcat(buf, (ost->oc_material == MINERAL) ? " stone" : " gem");
             if (un)
                 sprintf(eos(buf), " called %s", un);
         }
@@ -212,11 +213,11 @@ obj_typename(int otyp)
 char *
 simple_typename(int otyp)
 {
-    char *bufp, *pp, *save_uname = objects[otyp].oc_uname;
+    char *bufp, *pp, *save_uname = objstate[otyp].oc_uname;
 
-    objects[otyp].oc_uname = 0; /* suppress any name given by user */
+    objstate[otyp].oc_uname = 0; /* suppress any name given by user */
     bufp = obj_typename(otyp);
-    objects[otyp].oc_uname = save_uname;
+    objstate[otyp].oc_uname = save_uname;
     if ((pp = strstri(bufp, " (")) != 0)
         *pp = '\0';     /* strip the appended description */
     return bufp;
@@ -277,8 +278,8 @@ void
 examine_object(struct obj *obj)
 {
     int typ = obj->otyp;
-    struct objclass *ocl = &objects[typ];
-    int nn = ocl->oc_name_known;
+    const struct objclass *ocl = &objects[typ];
+    int nn = objstate[typ].oc_name_known;
 
     /* clean up known when it's tied to oc_name_known, eg after AD_DRIN */
     if (!nn && ocl->oc_uses_known && ocl->oc_unique)
@@ -302,11 +303,12 @@ xname2(const struct obj *obj, boolean ignore_oquan)
 {
     char *buf;
     int typ = obj->otyp;
-    struct objclass *ocl = &objects[typ];
-    int nn = ocl->oc_name_known;
-    const char *actualn = OBJ_NAME(*ocl);
-    const char *dn = OBJ_DESCR(*ocl);
-    const char *un = ocl->oc_uname;
+    const struct objclass *ocl = &objects[typ];
+    const struct objstate *ost = &objstate[typ];
+    int nn = ost->oc_name_known;
+    const char *actualn = OBJ_NAME(typ);
+    const char *dn = OBJ_DESCR(typ);
+    const char *un = ost->oc_uname;
     boolean known = obj->known;
     boolean dknown = obj->dknown;
     boolean bknown = obj->bknown;
@@ -530,7 +532,7 @@ xname2(const struct obj *obj, boolean ignore_oquan)
         break;
     case GEM_CLASS:
         {
-            const char *rock = (ocl->oc_material == MINERAL) ? "stone" : "gem";
+            const char *rock = (ost->oc_material == MINERAL) ? "stone" : "gem";
 
             if (!dknown) {
                 strcpy(buf, rock);
@@ -702,7 +704,7 @@ doname_base(const struct obj *obj, boolean with_price)
 #endif
 
     if (obj->bknown && obj->oclass != COIN_CLASS &&
-        (obj->otyp != POT_WATER || !objects[POT_WATER].oc_name_known ||
+        (obj->otyp != POT_WATER || !objstate[POT_WATER].oc_name_known ||
          (!obj->cursed && !obj->blessed))) {
         /* allow 'blessed clear potion' if we don't know it's holy water;
            always allow "uncursed potion of water" */
@@ -931,7 +933,7 @@ not_fully_identified_core(const struct obj * otmp, boolean ignore_bknown)
 
     /* check fundamental ID hallmarks first */
     if (!otmp->known || !otmp->dknown || (!ignore_bknown && !otmp->bknown) ||
-        !objects[otmp->otyp].oc_name_known)       /* ?redundant? */
+        !objstate[otmp->otyp].oc_name_known)       /* ?redundant? */
         return TRUE;
     if (otmp->oartifact && undiscovered_artifact(otmp->oartifact))
         return TRUE;
@@ -1021,17 +1023,17 @@ killer_xname(const struct obj *obj_orig)
     if (!obj->oartifact)
         obj->onamelth = 0;
     /* temporarily identify the type of object */
-    save_ocknown = objects[obj->otyp].oc_name_known;
-    objects[obj->otyp].oc_name_known = 1;
-    save_ocuname = objects[obj->otyp].oc_uname;
-    objects[obj->otyp].oc_uname = 0;    /* avoid "foo called bar" */
+    save_ocknown = objstate[obj->otyp].oc_name_known;
+    objstate[obj->otyp].oc_name_known = 1;
+    save_ocuname = objstate[obj->otyp].oc_uname;
+    objstate[obj->otyp].oc_uname = 0;    /* avoid "foo called bar" */
 
     buf = cxname(obj);
     if (obj->quan == 1L)
         buf = obj_is_pname(obj) ? the(buf) : an(buf);
 
-    objects[obj->otyp].oc_name_known = save_ocknown;
-    objects[obj->otyp].oc_uname = save_ocuname;
+    objstate[obj->otyp].oc_name_known = save_ocknown;
+    objstate[obj->otyp].oc_uname = save_ocuname;
 
     free(obj);
     return buf;
@@ -2293,7 +2295,7 @@ srch:
         for (i = bases[GEM_CLASS]; i <= LAST_GEM; i++) {
             const char *zn;
 
-            if ((zn = OBJ_NAME(objects[i])) && !strcmpi(actualn, zn)) {
+            if ((zn = OBJ_NAME(i)) && !strcmpi(actualn, zn)) {
                 typ = i;
                 goto typfnd;
             }
@@ -2303,20 +2305,21 @@ srch:
     while (i < NUM_OBJECTS && (!oclass || objects[i].oc_class == oclass)) {
         const char *zn;
 
-        if (actualn && (zn = OBJ_NAME(objects[i])) != 0 &&
+        if (actualn && (zn = OBJ_NAME(i)) != 0 &&
             wishymatch(actualn, zn, TRUE)) {
             typ = i;
             goto typfnd;
         }
-        if (dn && (zn = OBJ_DESCR(objects[i])) != 0 &&
+        if (dn && (zn = OBJ_DESCR(i)) != 0 &&
             wishymatch(dn, zn, FALSE)) {
             /* don't match extra descriptions (w/o real name) */
-            if (!OBJ_NAME(objects[i]))
+            if (!OBJ_NAME(i))
                 return NULL;
             typ = i;
             goto typfnd;
         }
-        if (un && (zn = objects[i].oc_uname) != 0 && wishymatch(un, zn, FALSE)) {
+        if (un && (zn = objstate[i].oc_uname) != 0 &&
+            wishymatch(un, zn, FALSE)) {
             typ = i;
             goto typfnd;
         }
@@ -2797,12 +2800,12 @@ rnd_class(int first, int last)
     if (first == last)
         return first;
     for (i = first; i <= last; i++)
-        sum += objects[i].oc_prob;
+        sum += objstate[i].oc_prob;
     if (!sum)   /* all zero */
         return first + rn2(last - first + 1);
     x = rnd(sum);
     for (i = first; i <= last; i++)
-        if (objects[i].oc_prob && (x -= objects[i].oc_prob) <= 0)
+        if (objstate[i].oc_prob && (x -= objstate[i].oc_prob) <= 0)
             return i;
     return 0;
 }
@@ -2830,7 +2833,7 @@ cloak_simple_name(const struct obj *cloak)
         case MUMMY_WRAPPING:
             return "wrapping";
         case ALCHEMY_SMOCK:
-            return (objects[cloak->otyp].oc_name_known &&
+            return (objstate[cloak->otyp].oc_name_known &&
                     cloak->dknown) ? "smock" : "apron";
         default:
             break;
@@ -2843,7 +2846,7 @@ const char *
 mimic_obj_name(const struct monst *mtmp)
 {
     if (mtmp->m_ap_type == M_AP_OBJECT && mtmp->mappearance != STRANGE_OBJECT) {
-        int idx = objects[mtmp->mappearance].oc_descr_idx;
+        int idx = objstate[mtmp->mappearance].oc_descr_idx;
 
         if (mtmp->mappearance == GOLD_PIECE)
             return "gold";
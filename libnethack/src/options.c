@@ -135,11 +135,17 @@ static const struct nh_option_desc const_options[] = {
     {"autoquiver",
      "when firing with an empty quiver, select something suitable",
      OPTTYPE_BOOL, {VFALSE}},
+    {"cold_levels",
+     "compress levels not visited for this many turns (0 = never)",
+     OPTTYPE_INT, {(void *)0}},
     {"comment", "has no effect", OPTTYPE_STRING, {""}},
     {"confirm", "ask before hitting tame or peaceful monsters", OPTTYPE_BOOL,
      {VTRUE}},
     {"disclose", "whether to disclose information at end of game", OPTTYPE_ENUM,
      {(void *)DISCLOSE_PROMPT_DEFAULT_YES}},
+    {"fast_forward",
+     "take up to this many steps of a multi-turn command at once (0 = off)",
+     OPTTYPE_INT, {(void *)0}},
     {"fruit", "the name of a fruit you enjoy eating", OPTTYPE_STRING,
      {"slime mold"}},
     {"lit_corridor", "show a dark corridor as lit if in sight", OPTTYPE_BOOL,
@@ -154,6 +160,9 @@ static const struct nh_option_desc const_options[] = {
      {VTRUE}},
     {"prayconfirm", "use confirmation prompt when #pray command issued",
      OPTTYPE_BOOL, {VTRUE}},
+    {"pregen_levels",
+     "prepare unvisited levels in the background while on stairs",
+     OPTTYPE_BOOL, {VFALSE}},
     {"pushweapon",
      "when wielding a new weapon, put your previous weapon into the secondary weapon slot",
      OPTTYPE_BOOL, {VFALSE}},
@@ -210,6 +219,7 @@ static const struct nh_boolopt_map boolopt_map[] = {
     {"lit_corridor", &flags.lit_corridor},
     {"pickup_thrown", &iflags.pickup_thrown},
     {"prayconfirm", &flags.prayconfirm},
+    {"pregen_levels", &iflags.pregen_levels},
     {"pushweapon", &flags.pushweapon},
     {"safe_pet", &flags.safe_dog},
     {"show_uncursed", &iflags.show_uncursed},
@@ -333,8 +343,12 @@ init_opt_struct(void)
     build_race_spec();
 
     /* initialize option definitions */
+    find_option(options, "cold_levels")->i.min = 0;
+    find_option(options, "cold_levels")->i.max = 1000000;
     find_option(options, "comment")->s.maxlen = BUFSZ;
     find_option(options, "disclose")->e = disclose_spec;
+    find_option(options, "fast_forward")->i.min = 0;
+    find_option(options, "fast_forward")->i.max = 10000;
     find_option(options, "fruit")->s.maxlen = PL_FSIZ;
     find_option(options, "menustyle")->e = menustyle_spec;
     find_option(options, "pickup_burden")->e = pickup_burden_spec;
@@ -638,13 +652,18 @@ set_option(const char *name, union nh_optvalue value, boolean isstring)
     } else if (is_ui)
         return ui_option_callback(option);
     /* regular non-boolean options */
-    else if (!strcmp("comment", option->name)) {
+    else if (!strcmp("cold_levels", option->name)) {
+        iflags.cold_levels = option->value.i;
+    } else if (!strcmp("comment", option->name)) {
         /* do nothing */
     } else if (!strcmp("disclose", option->name)) {
         flags.end_disclose = option->value.e;
+    } else if (!strcmp("fast_forward", option->name)) {
+        iflags.fast_forward = option->value.i;
     } else if (!strcmp("fruit", option->name)) {
         strncpy(pl_fruit, option->value.s, PL_FSIZ);
-        if (objects)    /* don't do fruitadd before the game is running */
+        if (objstate_valid)     /* don't do fruitadd before the game is
+                                   running */
             fruitadd(pl_fruit);
     } else if (!strcmp("menustyle", option->name)) {
         flags.menu_style = option->value.e;
@@ -662,6 +681,7 @@ set_option(const char *name, union nh_optvalue value, boolean isstring)
             iflags.ap_rules = NULL;
         }
         iflags.ap_rules = copy_autopickup_rules(option->value.ar);
+        reset_autopickup_matcher();
     }
     /* birth options */
     else if (!strcmp("align", option->name)) {
@@ -844,7 +864,7 @@ fruitadd(const char *str)
         boolean found = FALSE, numeric = FALSE;
 
         for (i = bases[FOOD_CLASS]; objects[i].oc_class == FOOD_CLASS; i++) {
-            if (i != SLIME_MOLD && !strcmp(OBJ_NAME(objects[i]), pl_fruit)) {
+            if (i != SLIME_MOLD && !strcmp(OBJ_NAME(i), pl_fruit)) {
                 found = TRUE;
                 break;
             }
@@ -434,6 +434,204 @@ nh_describe_pos(int x, int y, struct nh_desc_buf *bufs, int *is_in)
     api_exit();
 }
 
+/*
+ * The index of the "data" file, as written by makedefs -d: the position of the
+ * text of each entry, a hash table of the names without wildcards, and the
+ * few names with wildcards or a leading '~' in file order.  It's read once,
+ * so that a lookup doesn't have to scan and pmatch() every name in the file.
+ */
+struct dbase_name {
+    char *name;
+    int entry, pos;     /* entry it belongs to, and position within it */
+    boolean skip;       /* '~': a match skips the rest of the entry */
+};
+
+static struct dbase_index {
+    boolean loaded;
+    int nentries, nplain, nspecial;
+    long *offsets;      /* of each entry's text in the data file */
+    int *counts;        /* lines of text of each entry */
+    struct dbase_name *plain, *special;
+    int *hash;  /* indices into plain; -1 if unused */
+    int hashsize;
+} dbase_index;
+
+
+static unsigned int
+dbase_hash(const char *str)
+{
+    unsigned int h = 2166136261U;
+
+    while (*str)
+        h = (h ^ (unsigned char)*str++) * 16777619U;
+    return h;
+}
+
+
+void
+free_dbase_index(void)
+{
+    int i;
+
+    for (i = 0; i < dbase_index.nplain; i++)
+        free(dbase_index.plain[i].name);
+    for (i = 0; i < dbase_index.nspecial; i++)
+        free(dbase_index.special[i].name);
+    free(dbase_index.plain);
+    free(dbase_index.special);
+    free(dbase_index.offsets);
+    free(dbase_index.counts);
+    free(dbase_index.hash);
+    memset(&dbase_index, 0, sizeof (dbase_index));
+}
+
+
+static boolean
+read_dbase_name(dlb * fp, struct dbase_name *dn, boolean special)
+{
+    char buf[BUFSZ], skip;
+    int len;
+
+    if (!dlb_fgets(buf, BUFSZ, fp))
+        return FALSE;
+    if (special ? sscanf(buf, "%d %d %c %n", &dn->entry, &dn->pos, &skip,
+                         &len) < 3 :
+        sscanf(buf, "%d %d %n", &dn->entry, &dn->pos, &len) < 2)
+        return FALSE;
+    if (dn->entry < 0 || dn->entry >= dbase_index.nentries)
+        return FALSE;
+
+    dn->skip = special && skip == '~';
+    buf[strcspn(buf, "\n")] = '\0';
+    dn->name = strdup(buf + len);
+    return TRUE;
+}
+
+
+boolean
+load_dbase_index(void)
+{
+    dlb *fp;
+    char buf[BUFSZ];
+    int i, h;
+    struct dbase_index *di = &dbase_index;
+
+    if (di->loaded)
+        return TRUE;
+
+    fp = dlb_fopen(DATAINDEXFILE, "r");
+    if (!fp)
+        return FALSE;
+
+    /* skip the comment line */
+    if (!dlb_fgets(buf, BUFSZ, fp) || !dlb_fgets(buf, BUFSZ, fp) ||
+        sscanf(buf, "%d %d %d", &di->nentries, &di->nplain,
+               &di->nspecial) < 3)
+        goto bad_index;
+
+    di->offsets = malloc(di->nentries * sizeof (long));
+    di->counts = malloc(di->nentries * sizeof (int));
+    di->plain = calloc(di->nplain, sizeof (struct dbase_name));
+    di->special = calloc(di->nspecial, sizeof (struct dbase_name));
+
+    for (i = 0; i < di->nentries; i++)
+        if (!dlb_fgets(buf, BUFSZ, fp) ||
+            sscanf(buf, "%ld,%d", &di->offsets[i], &di->counts[i]) < 2)
+            goto bad_index;
+    for (i = 0; i < di->nplain; i++)
+        if (!read_dbase_name(fp, &di->plain[i], FALSE))
+            goto bad_index;
+    for (i = 0; i < di->nspecial; i++)
+        if (!read_dbase_name(fp, &di->special[i], TRUE))
+            goto bad_index;
+    dlb_fclose(fp);
+
+    for (di->hashsize = 16; di->hashsize < 2 * di->nplain;)
+        di->hashsize *= 2;
+    di->hash = malloc(di->hashsize * sizeof (int));
+    for (i = 0; i < di->hashsize; i++)
+        di->hash[i] = -1;
+    for (i = 0; i < di->nplain; i++) {
+        h = dbase_hash(di->plain[i].name) & (di->hashsize - 1);
+        while (di->hash[h] != -1)
+            h = (h + 1) & (di->hashsize - 1);
+        di->hash[h] = i;
+    }
+
+    di->loaded = TRUE;
+    return TRUE;
+
+bad_index:
+    dlb_fclose(fp);
+    free_dbase_index();
+    impossible("'%s' file in wrong format", DATAINDEXFILE);
+    return FALSE;
+}
+
+
+static boolean
+dbase_name_matches(const char *name, const char *str, const char *alt)
+{
+    return pmatch(name, str) || (alt && pmatch(name, alt));
+}
+
+
+/* A name only counts if no '~' name before it in the same entry matches. */
+static boolean
+dbase_name_skipped(int entry, int pos, const char *str, const char *alt)
+{
+    int i;
+    const struct dbase_name *dn;
+
+    for (i = 0; i < dbase_index.nspecial; i++) {
+        dn = &dbase_index.special[i];
+        if (dn->entry > entry)
+            break;
+        if (dn->entry == entry && dn->skip && dn->pos < pos &&
+            dbase_name_matches(dn->name, str, alt))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+
+/* Find the first entry with a name matching str or alt; returns -1 if there
+   is none.  This gives the same result as trying the names in file order. */
+static int
+dbase_lookup(const char *str, const char *alt)
+{
+    int best = -1, i, h, pass;
+    const char *key;
+    const struct dbase_name *dn;
+
+    for (pass = 0; pass < 2; pass++) {
+        key = pass ? alt : str;
+        if (!key)
+            continue;
+        for (h = dbase_hash(key) & (dbase_index.hashsize - 1);
+             (i = dbase_index.hash[h]) != -1;
+             h = (h + 1) & (dbase_index.hashsize - 1)) {
+            dn = &dbase_index.plain[i];
+            if ((best < 0 || dn->entry < best) && !strcmp(dn->name, key) &&
+                !dbase_name_skipped(dn->entry, dn->pos, str, alt))
+                best = dn->entry;
+        }
+    }
+
+    /* the special names are in file order, so the first match is the only
+       one that can precede the plain names' entry */
+    for (i = 0; i < dbase_index.nspecial; i++) {
+        dn = &dbase_index.special[i];
+        if (best >= 0 && dn->entry >= best)
+            break;
+        if (!dn->skip && dbase_name_matches(dn->name, str, alt) &&
+            !dbase_name_skipped(dn->entry, dn->pos, str, alt))
+            return dn->entry;
+    }
+    return best;
+}
+
+
 /*
  * Look in the "data" file for more info.  Called if the user typed in the
  * whole name (user_typed_name == TRUE), or we've found a possible match
@@ -446,12 +644,9 @@ checkfile(const char *inp, struct permonst *pm, boolean user_typed_name,
     dlb *fp;
     char buf[BUFSZ], newstr[BUFSZ];
     char *ep, *dbase_str;
-    long txt_offset;
-    int chk_skip;
-    boolean found_in_file = FALSE, skipping_entry = FALSE;
+    int entry = -1;
 
-    fp = dlb_fopen(DATAFILE, "r");
-    if (!fp) {
+    if (!load_dbase_index()) {
         pline("Cannot open data file!");
         return;
     }
@@ -515,79 +710,39 @@ checkfile(const char *inp, struct permonst *pm, boolean user_typed_name,
         else if (user_typed_name)
             lcase(alt);
 
-        /* skip first record; read second */
-        txt_offset = 0L;
-        if (!dlb_fgets(buf, BUFSZ, fp) || !dlb_fgets(buf, BUFSZ, fp)) {
-            impossible("can't read 'data' file");
-            dlb_fclose(fp);
-            return;
-        } else if (sscanf(buf, "%8lx\n", &txt_offset) < 1 || txt_offset <= 0)
-            goto bad_data_file;
-
-        /* look for the appropriate entry */
-        while (dlb_fgets(buf, BUFSZ, fp)) {
-            if (*buf == '.')
-                break;  /* we passed last entry without success */
-
-            if (digit(*buf)) {
-                /* a number indicates the end of current entry */
-                skipping_entry = FALSE;
-            } else if (!skipping_entry) {
-                if (!(ep = strchr(buf, '\n')))
-                    goto bad_data_file;
-                *ep = 0;
-                /* if we match a key that begins with "~", skip this entry */
-                chk_skip = (*buf == '~') ? 1 : 0;
-                if (pmatch(&buf[chk_skip], dbase_str) ||
-                    (alt && pmatch(&buf[chk_skip], alt))) {
-                    if (chk_skip) {
-                        skipping_entry = TRUE;
-                        continue;
-                    } else {
-                        found_in_file = TRUE;
-                        break;
-                    }
-                }
-            }
-        }
+        entry = dbase_lookup(dbase_str, alt);
     }
 
-    if (found_in_file) {
-        long entry_offset;
-        int entry_count;
+    if (entry >= 0) {
         int i;
 
-        /* skip over other possible matches for the info */
-        do {
-            if (!dlb_fgets(buf, BUFSZ, fp))
-                goto bad_data_file;
-        } while (!digit(*buf));
-
-        if (sscanf(buf, "%ld,%d\n", &entry_offset, &entry_count) < 2) {
-        bad_data_file:impossible("'data' file in wrong format");
-            dlb_fclose(fp);
-            return;
-        }
-
         if (user_typed_name || without_asking || yn("More info?") == 'y') {
             struct menulist menu;
 
-            if (dlb_fseek(fp, txt_offset + entry_offset, SEEK_SET) < 0) {
+            fp = dlb_fopen(DATAFILE, "r");
+            if (!fp) {
+                pline("Cannot open data file!");
+                return;
+            }
+            if (dlb_fseek(fp, dbase_index.offsets[entry], SEEK_SET) < 0) {
                 pline("? Seek error on 'data' file!");
                 dlb_fclose(fp);
                 return;
             }
 
             init_menulist(&menu);
-            for (i = 0; i < entry_count; i++) {
-                if (!dlb_fgets(buf, BUFSZ, fp))
-                    goto bad_data_file;
+            for (i = 0; i < dbase_index.counts[entry]; i++) {
+                if (!dlb_fgets(buf, BUFSZ, fp)) {
+                    impossible("'data' file in wrong format");
+                    break;
+                }
                 if ((ep = strchr(buf, '\n')) != 0)
                     *ep = 0;
                 if (strchr(buf + 1, '\t') != 0)
                     tabexpand(buf + 1);
                 add_menutext(&menu, buf + 1);
             }
+            dlb_fclose(fp);
 
             display_menu(menu.items, menu.icount, NULL, FALSE, PLHINT_ANYWHERE,
                          NULL);
@@ -595,8 +750,6 @@ checkfile(const char *inp, struct permonst *pm, boolean user_typed_name,
         }
     } else if (user_typed_name)
         pline("I don't have any information on those things.");
-
-    dlb_fclose(fp);
 }
 
 
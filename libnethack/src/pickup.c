@@ -297,18 +297,149 @@ menu_pickup:
 }
 
 
+/*
+ * The autopickup rules are compiled the first time they are needed after they
+ * change.  Rules are ordered and the first match decides, so for every
+ * combination of object class and buc status we keep the rules which could
+ * apply to such an object, cut off after the first one without a pattern:
+ * that rule always matches and nothing after it can be reached.  Matching
+ * then only looks at pattern rules of the right class and buc, and only
+ * formats the (expensive) object description if there is one.
+ */
+
+enum ap_pattern_kind {
+    APK_NONE,   /* empty pattern, matches everything */
+    APK_LITERAL,        /* no wildcards; compare as a plain string */
+    APK_GLOB    /* wildcards; check the fixed ends before pmatch() */
+};
+
+struct ap_compiled_rule {
+    const char *pattern;
+    enum ap_pattern_kind kind;
+    int prefixlen;      /* length of the text before the first wildcard */
+    int suffixlen;      /* length of the text after the last wildcard */
+};
+
+#define AP_NBUC (B_CURSED + 1)  /* buc states an object can have */
+
+static struct ap_matcher {
+    boolean valid;
+    struct ap_compiled_rule *rules;
+    short *candidates;  /* rule indices, per class and buc */
+    int first[MAXOCLASSES][AP_NBUC];    /* start of the list in candidates */
+    int count[MAXOCLASSES][AP_NBUC];
+    /* the result if none of the candidates match: -1 for no match,
+       otherwise the index of the rule without pattern that matches */
+    int fallback[MAXOCLASSES][AP_NBUC];
+} ap_matcher;
+
+
+/* Forget the compiled autopickup rules; must be called whenever iflags.ap_rules
+   is replaced or freed. */
+void
+reset_autopickup_matcher(void)
+{
+    free(ap_matcher.rules);
+    free(ap_matcher.candidates);
+    memset(&ap_matcher, 0, sizeof (ap_matcher));
+}
+
+
+static void
+compile_ap_rules(const struct nh_autopickup_rules *ar)
+{
+    int i, c, b, n;
+    const char *p;
+    const struct nh_autopickup_rule *r;
+    struct ap_compiled_rule *cr;
+
+    reset_autopickup_matcher();
+    ap_matcher.rules = malloc(ar->num_rules * sizeof (struct ap_compiled_rule));
+    ap_matcher.candidates =
+        malloc(MAXOCLASSES * AP_NBUC * ar->num_rules * sizeof (short));
+
+    for (i = 0; i < ar->num_rules; i++) {
+        r = &ar->rules[i];
+        cr = &ap_matcher.rules[i];
+        cr->pattern = r->pattern;
+        cr->prefixlen = cr->suffixlen = 0;
+        if (!r->pattern[0]) {
+            cr->kind = APK_NONE;
+            continue;
+        }
+
+        p = strpbrk(r->pattern, "*?");
+        if (!p) {
+            cr->kind = APK_LITERAL;
+            continue;
+        }
+        cr->kind = APK_GLOB;
+        cr->prefixlen = p - r->pattern;
+        for (p = r->pattern + strlen(r->pattern); p > r->pattern; p--)
+            if (p[-1] == '*' || p[-1] == '?')
+                break;
+        cr->suffixlen = strlen(p);
+    }
+
+    for (n = 0, c = 0; c < MAXOCLASSES; c++) {
+        for (b = 0; b < AP_NBUC; b++) {
+            ap_matcher.first[c][b] = n;
+            ap_matcher.fallback[c][b] = -1;
+            for (i = 0; i < ar->num_rules; i++) {
+                r = &ar->rules[i];
+                if ((r->oclass != OCLASS_ANY && r->oclass != def_oc_syms[c]) ||
+                    (r->buc != B_DONT_CARE && r->buc != b))
+                    continue;
+                if (ap_matcher.rules[i].kind == APK_NONE) {
+                    ap_matcher.fallback[c][b] = i;
+                    break;
+                }
+                ap_matcher.candidates[n++] = i;
+            }
+            ap_matcher.count[c][b] = n - ap_matcher.first[c][b];
+        }
+    }
+
+    ap_matcher.valid = TRUE;
+}
+
+
+static boolean
+ap_pattern_match(const struct ap_compiled_rule *cr, const char *objdesc,
+                 int desclen)
+{
+    switch (cr->kind) {
+    case APK_NONE:
+        return TRUE;
+    case APK_LITERAL:
+        return !strcmp(cr->pattern, objdesc);
+    case APK_GLOB:
+        if (desclen < cr->prefixlen + cr->suffixlen)
+            return FALSE;
+        if (strncmp(cr->pattern, objdesc, cr->prefixlen))
+            return FALSE;
+        if (strcmp(cr->pattern + strlen(cr->pattern) - cr->suffixlen,
+                   objdesc + desclen - cr->suffixlen))
+            return FALSE;
+        return pmatch(cr->pattern, objdesc);
+    }
+    return FALSE;
+}
+
+
 static boolean
 autopickup_match(struct obj *obj)
 {
-    int i;
-    struct nh_autopickup_rule *r;
-    char *objdesc;
+    int i, n, ri, desclen = 0;
+    const char *objdesc = NULL;
     enum nh_bucstatus objbuc;
+    const short *cand;
 
     if (!iflags.ap_rules)
         return FALSE;
+    if (!ap_matcher.valid)
+        compile_ap_rules(iflags.ap_rules);
 
-    objdesc = makesingular(doname_price(obj));
     if (obj->bknown) {
         if (obj->blessed)
             objbuc = B_BLESSED;
@@ -319,17 +450,22 @@ autopickup_match(struct obj *obj)
     } else
         objbuc = B_UNKNOWN;
 
-    /* test the aotupickup rules in order. If any of the rules matches this
-       object, return the result */
-    r = &iflags.ap_rules->rules[0];
-    for (i = 0; i < iflags.ap_rules->num_rules; i++, r++) {
-        if ((!strlen(r->pattern) || pmatch(r->pattern, objdesc)) &&
-            (r->oclass == OCLASS_ANY ||
-             r->oclass == def_oc_syms[(int)obj->oclass]) &&
-            (r->buc == B_DONT_CARE || r->buc == objbuc))
-            return r->action == AP_GRAB;
+    /* test the candidate rules in order. If any of them matches this object,
+       return the result */
+    cand = &ap_matcher.candidates[ap_matcher.first[(int)obj->oclass][objbuc]];
+    n = ap_matcher.count[(int)obj->oclass][objbuc];
+    for (i = 0; i < n; i++) {
+        ri = cand[i];
+        if (!objdesc) {
+            objdesc = makesingular(doname_price(obj));
+            desclen = strlen(objdesc);
+        }
+        if (ap_pattern_match(&ap_matcher.rules[ri], objdesc, desclen))
+            return iflags.ap_rules->rules[ri].action == AP_GRAB;
     }
-    return FALSE;
+
+    ri = ap_matcher.fallback[(int)obj->oclass][objbuc];
+    return ri >= 0 && iflags.ap_rules->rules[ri].action == AP_GRAB;
 }
 
 
@@ -377,7 +513,6 @@ add_objitem(struct nh_objitem **items, int *nr_items,
             struct obj *obj, boolean use_invlet)
 {
     struct nh_objitem *it;
-    struct objclass *ocl;
 
     if (idx >= *nr_items) {
         *nr_items = *nr_items * 2;
@@ -392,8 +527,6 @@ add_objitem(struct nh_objitem **items, int *nr_items,
     strcpy(it->caption, caption);
 
     if (role == MI_NORMAL && obj) {
-        ocl = &objects[obj->otyp];
-
         it->count = obj->quan;
         it->accel = use_invlet ? obj->invlet : 0;
         it->group_accel = def_oc_syms[(int)obj->oclass];
@@ -403,7 +536,8 @@ add_objitem(struct nh_objitem **items, int *nr_items,
 
         /* don't unconditionally reveal weight, otherwise lodestones on the
            floor could be identified by their weight in the pickup dialog */
-        if (obj->where == OBJ_INVENT || ocl->oc_name_known || obj->invlet ||
+        if (obj->where == OBJ_INVENT || objstate[obj->otyp].oc_name_known ||
+            obj->invlet ||
             (obj->where == OBJ_CONTAINED &&
              obj->ocontainer->where == OBJ_INVENT))
             it->weight = obj->owt;
@@ -1045,8 +1179,8 @@ pickup_object(struct obj *obj, long count, boolean telekinesis)
             pline("The scroll%s %s to dust as you %s %s up.", plur(obj->quan),
                   otense(obj, "turn"), telekinesis ? "raise" : "pick",
                   (obj->quan == 1L) ? "it" : "them");
-            if (!(objects[SCR_SCARE_MONSTER].oc_name_known) &&
-                !(objects[SCR_SCARE_MONSTER].oc_uname))
+            if (!(objstate[SCR_SCARE_MONSTER].oc_name_known) &&
+                !(objstate[SCR_SCARE_MONSTER].oc_uname))
                 docall(obj);
             useupf(obj, obj->quan);
             return 1;   /* tried to pick something up and failed, but don't
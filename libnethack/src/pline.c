@@ -176,6 +176,7 @@ impossible(const char *s, ...)
     va_list the_args;
 
     va_start(the_args, s);
+    pregen_worker_abort();      /* don't write to the paniclog from a worker */
     if (program_state.in_impossible)
         panic("impossible called impossible");
     program_state.in_impossible = 1;
@@ -382,7 +382,7 @@ dodrink(struct obj *potion)
 
 #define POTION_OCCUPANT_CHANCE(n) (13 + 2*(n))  /* also in muse.c */
 
-    potion_descr = OBJ_DESCR(objects[potion->otyp]);
+    potion_descr = OBJ_DESCR(potion->otyp);
     if (potion_descr) {
         if (!strcmp(potion_descr, "milky") && flags.ghost_count < MAXMONNO &&
             !rn2(POTION_OCCUPANT_CHANCE(flags.ghost_count))) {
@@ -422,11 +422,11 @@ dopotion(struct obj *otmp)
         pline("You have a %s feeling for a moment, then it passes.",
               Hallucination ? "normal" : "peculiar");
     }
-    if (otmp->dknown && !objects[otmp->otyp].oc_name_known) {
+    if (otmp->dknown && !objstate[otmp->otyp].oc_name_known) {
         if (!unkn) {
             makeknown(otmp->otyp);
             more_experienced(0, 10);
-        } else if (!objects[otmp->otyp].oc_uname)
+        } else if (!objstate[otmp->otyp].oc_uname)
             docall(otmp);
     }
     useup(otmp);
@@ -975,8 +975,8 @@ strange_feeling(struct obj *obj, const char *txt)
     if (!obj)   /* e.g., crystal ball finds no traps */
         return;
 
-    if (obj->dknown && !objects[obj->otyp].oc_name_known &&
-        !objects[obj->otyp].oc_uname)
+    if (obj->dknown && !objstate[obj->otyp].oc_name_known &&
+        !objstate[obj->otyp].oc_uname)
         docall(obj);
     useup(obj);
 }
@@ -1213,8 +1213,8 @@ potionhit(struct monst *mon, struct obj *obj, boolean your_fault)
     if ((distance == 0 || ((distance < 3) && rn2(5))) &&
         (!breathless(youmonst.data) || haseyes(youmonst.data)))
         potionbreathe(obj);
-    else if (obj->dknown && !objects[obj->otyp].oc_name_known &&
-             !objects[obj->otyp].oc_uname && cansee(mon->mx, mon->my))
+    else if (obj->dknown && !objstate[obj->otyp].oc_name_known &&
+             !objstate[obj->otyp].oc_uname && cansee(mon->mx, mon->my))
         docall(obj);
     if (*u.ushops && obj->unpaid) {
         struct monst *shkp =
@@ -1384,8 +1384,8 @@ potionbreathe(struct obj *obj)
     if (obj->dknown) {
         if (kn)
             makeknown(obj->otyp);
-        else if (!objects[obj->otyp].oc_name_known &&
-                 !objects[obj->otyp].oc_uname)
+        else if (!objstate[obj->otyp].oc_name_known &&
+                 !objstate[obj->otyp].oc_uname)
             docall(obj);
     }
 }
@@ -1656,8 +1656,8 @@ dodip(struct obj *potion)
                 uncurse(obj);
                 obj->bknown = 1;
             poof:
-                if (!(objects[potion->otyp].oc_name_known) &&
-                    !(objects[potion->otyp].oc_uname))
+                if (!(objstate[potion->otyp].oc_name_known) &&
+                    !(objstate[potion->otyp].oc_uname))
                     docall(potion);
                 useup(potion);
                 return 1;
@@ -1790,7 +1790,7 @@ dodip(struct obj *potion)
             pline("The mixture bubbles%s.", Blind ? "" : ", then clears");
         } else if (!Blind) {
             pline("The mixture looks %s.",
-                  hcolor(OBJ_DESCR(objects[obj->otyp])));
+                  hcolor(OBJ_DESCR(obj->otyp)));
         }
 
         useup(potion);
@@ -1844,7 +1844,7 @@ dodip(struct obj *potion)
         boolean wisx = FALSE;
 
         if (potion->lamplit) {  /* burning */
-            int omat = objects[obj->otyp].oc_material;
+            int omat = objstate[obj->otyp].oc_material;
 
             /* the code here should be merged with fire_damage */
             if (catch_lit(obj)) {
@@ -1950,7 +1950,7 @@ more_dips:
         oldbuf[0] = '\0';
         if (potion->dknown) {
             old_dknown = TRUE;
-            sprintf(oldbuf, "%s ", hcolor(OBJ_DESCR(objects[potion->otyp])));
+            sprintf(oldbuf, "%s ", hcolor(OBJ_DESCR(potion->otyp)));
         }
         /* with multiple merged potions, split off one and just clear it */
         if (potion->quan > 1L) {
@@ -1977,11 +1977,11 @@ more_dips:
                 sprintf(newbuf, "clears");
             else
                 sprintf(newbuf, "turns %s",
-                        hcolor(OBJ_DESCR(objects[mixture])));
+                        hcolor(OBJ_DESCR(mixture)));
             pline("The %spotion%s %s.", oldbuf,
                   more_than_one ? " that you dipped into" : "", newbuf);
-            if (!objects[old_otyp].oc_uname && !objects[old_otyp].oc_name_known
-                && old_dknown) {
+            if (!objstate[old_otyp].oc_uname &&
+                !objstate[old_otyp].oc_name_known && old_dknown) {
                 struct obj fakeobj;
 
                 fakeobj = zeroobj;
@@ -1044,7 +1044,7 @@ pleased(aligntyp g_align)
                             !P_RESTRICTED(spell_skilltype(otmp->otyp)))
                             break;      /* usable, but not yet known */
                     } else {
-                        if (!objects[SPE_BLANK_PAPER].oc_name_known ||
+                        if (!objstate[SPE_BLANK_PAPER].oc_name_known ||
                             carrying(MAGIC_MARKER))
                             break;
                     }
@@ -1761,7 +1761,7 @@ doturn(void)
 
     if (!Role_if(PM_PRIEST) && !Role_if(PM_KNIGHT)) {
         /* Try to use turn undead spell. */
-        if (objects[SPE_TURN_UNDEAD].oc_name_known) {
+        if (objstate[SPE_TURN_UNDEAD].oc_name_known) {
             int sp_no;
 
             for (sp_no = 0;
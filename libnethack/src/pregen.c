@@ -0,0 +1,555 @@
+/* vim:set cin ft=c sw=4 sts=4 ts=8 et ai cino=Ls\:0t0(0 : -*- mode:c;fill-column:80;tab-width:8;c-basic-offset:4;indent-tabs-mode:nil;c-file-style:"k&r" -*-*/
+/* NetHack may be freely redistributed.  See license for details. */
+
+/* Background generation of the level behind the stairs the hero stands on
+ * (the "pregen_levels" option).
+ *
+ * After a command, if the hero is on stairs or a ladder leading to a level
+ * that doesn't exist yet, a worker process is forked from the game.  It
+ * silently performs the move up or down itself, and when goto_level() is
+ * about to call mklev() it records a hash of the game state that level
+ * creation depends on, makes the level and pipes the result back.  If the
+ * player then really takes the stairs, the parent computes the same hash at
+ * the same point; only if it matches (i.e. the RNG and everything else mklev()
+ * reads are exactly what the worker started from) is the worker's level used
+ * instead of calling mklev().  Otherwise the result is thrown away and the
+ * level is made as usual, so the game is the same with or without the option.
+ *
+ * Besides the level itself, making a level changes the following game-wide
+ * state, all of which the worker sends along: the RNG, rndmonst's cache,
+ * the identifier and unique-monster counters in flags, mvitals, artifact
+ * existence, the quest leader's id, the timer id counter, the dungeon branch
+ * list (the Ludios portal) and the invocation position.  Messages printed
+ * while the level was made are passed on as well.  If bones would be loaded,
+ * the worker gives up; only the real game may use up a bones file.
+ */
+
+#include "hack.h"
+#include "quest.h"
+
+#if defined(UNIX)
+# include <signal.h>
+# include <sys/types.h>
+# include <sys/wait.h>
+# include <unistd.h>
+
+# define PREGEN_MAGIC 0x50524547        /* "PREG" */
+
+static pid_t worker_pid = 0;
+static int worker_fd = -1;
+static xchar worker_ledger;
+
+/* the following are only used inside a worker */
+static boolean in_worker = FALSE;
+static boolean capture_msgs = FALSE;
+static struct memfile msgbuf;
+static int msgcount;
+
+
+/* window procs for the worker: it must never talk to the real interface */
+
+static void
+worker_pause(enum nh_pause_reason reason)
+{
+}
+
+static void
+worker_display_buffer(const char *buf, boolean trymove)
+{
+}
+
+static void
+worker_update_status(struct nh_player_info *pi)
+{
+}
+
+static void
+worker_print_message(int turn, const char *msg)
+{
+    int len = strlen(msg);
+
+    if (!capture_msgs)
+        return;
+    mwrite32(&msgbuf, len);
+    mwrite(&msgbuf, msg, len);
+    msgcount++;
+}
+
+static int
+worker_display_menu(struct nh_menuitem *items, int icount, const char *title,
+                    int how, int placement_hint, int *results)
+{
+    return -1;
+}
+
+static int
+worker_display_objects(struct nh_objitem *items, int icount,
+                       const char *title, int how, int placement_hint,
+                       struct nh_objresult *pick_list)
+{
+    return -1;
+}
+
+static boolean
+worker_list_items(struct nh_objitem *items, int icount, boolean invent)
+{
+    return FALSE;
+}
+
+static void
+worker_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
+{
+}
+
+static void
+worker_raw_print(const char *str)
+{
+}
+
+/* Any prompt means the command isn't a plain trip up or down the stairs;
+   answering ESC everywhere makes the worker's copy of the command give up. */
+static char
+worker_query_key(const char *query, int *count)
+{
+    if (count)
+        *count = -1;
+    return '\033';
+}
+
+static int
+worker_getpos(int *x, int *y, boolean force, const char *goal)
+{
+    pregen_worker_abort();
+    return -1;
+}
+
+static enum nh_direction
+worker_getdir(const char *query, boolean restricted)
+{
+    return DIR_NONE;
+}
+
+static char
+worker_yn_function(const char *query, const char *rset, char defchoice)
+{
+    return '\033';
+}
+
+static void
+worker_getlin(const char *query, char *buf)
+{
+    strcpy(buf, "\033");
+}
+
+static void
+worker_delay(void)
+{
+}
+
+static void
+worker_level_changed(int displaymode)
+{
+}
+
+static void
+worker_outrip(struct nh_menuitem *items, int icount, boolean tombstone,
+              const char *name, int gold, const char *killbuf, int end_how,
+              int year)
+{
+}
+
+static const struct nh_window_procs worker_windowprocs = {
+    worker_pause,
+    worker_display_buffer,
+    worker_update_status,
+    worker_print_message,
+    worker_display_menu,
+    worker_display_objects,
+    worker_list_items,
+    worker_update_screen,
+    worker_raw_print,
+    worker_query_key,
+    worker_getpos,
+    worker_getdir,
+    worker_yn_function,
+    worker_getlin,
+    worker_delay,
+    worker_level_changed,
+    worker_outrip,
+    worker_print_message,
+};
+
+
+/* Decide whether the hero is on stairs leading to a level that hasn't been
+   made yet; if so, fill in where they go and which way. */
+static boolean
+unmade_level_ahead(d_level * dest, enum nh_direction *dir)
+{
+    if ((u.ux == level->dnstair.sx && u.uy == level->dnstair.sy) ||
+        (u.ux == level->dnladder.sx && u.uy == level->dnladder.sy)) {
+        if (Is_botlevel(&u.uz))
+            return FALSE;
+        dest->dnum = u.uz.dnum;
+        dest->dlevel = u.uz.dlevel + 1;
+        *dir = DIR_DOWN;
+    } else if ((u.ux == level->upstair.sx && u.uy == level->upstair.sy) ||
+               (u.ux == level->upladder.sx && u.uy == level->upladder.sy)) {
+        if (u.uz.dlevel <= 1)
+            return FALSE;       /* leaving the dungeon or a branch */
+        dest->dnum = u.uz.dnum;
+        dest->dlevel = u.uz.dlevel - 1;
+        *dir = DIR_UP;
+    } else if (u.ux == level->sstairs.sx && u.uy == level->sstairs.sy &&
+               level->sstairs.sx) {
+        assign_level(dest, &level->sstairs.tolev);
+        *dir = level->sstairs.up ? DIR_UP : DIR_DOWN;
+    } else
+        return FALSE;
+
+    return ledger_no(dest) > 0 && ledger_no(dest) <= maxledgerno() &&
+        !level_exists(ledger_no(dest)) && !In_endgame(dest);
+}
+
+
+/* kill off a worker whose result wasn't needed */
+void
+pregen_discard(void)
+{
+    if (worker_pid <= 0)
+        return;
+
+    kill(worker_pid, SIGKILL);
+    waitpid(worker_pid, NULL, 0);
+    close(worker_fd);
+    worker_pid = 0;
+    worker_fd = -1;
+}
+
+
+/* Called when a command has finished and the game waits for input. */
+void
+pregen_after_command(void)
+{
+    d_level dest;
+    enum nh_direction dir;
+    struct nh_cmd_arg arg;
+    int fds[2];
+
+    pregen_discard();
+
+    if (!iflags.pregen_levels || program_state.viewing ||
+        program_state.restoring || !program_state.game_running ||
+        u.uswallow || !unmade_level_ahead(&dest, &dir))
+        return;
+
+    if (pipe(fds) == -1)
+        return;
+
+    worker_pid = fork();
+    if (worker_pid == -1) {
+        worker_pid = 0;
+        close(fds[0]);
+        close(fds[1]);
+        return;
+    }
+
+    if (worker_pid > 0) {
+        close(fds[1]);
+        worker_fd = fds[0];
+        worker_ledger = ledger_no(&dest);
+        return;
+    }
+
+    /* in the worker: do what the "move" command sent for '>' or '<' would do,
+       without a log or an interface */
+    close(fds[0]);
+    worker_fd = fds[1];
+    in_worker = TRUE;
+    windowprocs = worker_windowprocs;
+    iflags.disable_log = TRUE;
+
+    if (api_entry_checkpoint()) {
+        arg.argtype = CMD_ARG_DIR;
+        arg.d = dir;
+        command_input(get_command_idx("move"), 0, &arg);
+    }
+    /* the command didn't reach mklev() */
+    _exit(1);
+}
+
+
+/* Used by a worker to give up when it would have to do something only the
+   real game may do; does nothing in the real game. */
+void
+pregen_worker_abort(void)
+{
+    if (in_worker)
+        _exit(1);
+}
+
+
+/* the game-wide state that making a level can change, apart from the level
+   itself (see the comment at the top) */
+static void
+save_pregen_state(struct memfile *mf)
+{
+    save_mt_state(mf);
+    save_rndmonst_state(mf);
+    save_artifacts(mf);
+    save_dungeon(mf);
+    mwrite(mf, mvitals, sizeof (mvitals));
+    mwrite(mf, &quest_status, sizeof (quest_status));
+    mwrite32(mf, timer_id);
+    mwrite32(mf, flags.ident);
+    mwrite32(mf, flags.no_of_wizards);
+    mwrite32(mf, flags.djinni_count);
+    mwrite32(mf, flags.ghost_count);
+    mwrite8(mf, flags.made_amulet);
+}
+
+
+/* A 64 bit FNV-1a hash of the game state that making a level reads or
+ * changes, apart from the level itself: what save_pregen_state() covers
+ * (the RNG among it), the save header (flags, the hero and the turn) and the
+ * fruit names.  Nothing else, such as other levels, the inventory or
+ * migrating monsters, goes into a new level.  A hash of a whole save would
+ * cost about as much on a big game as the mklev() call it is meant to spare. */
+static unsigned long long
+level_inputs_hash(void)
+{
+    struct memfile mf;
+    unsigned long long hash = 14695981039346656037ULL;
+    int i;
+
+    mnew(&mf, NULL);
+    save_header(&mf);
+    save_pregen_state(&mf);
+    mwrite32(&mf, current_fruit);
+    savefruitchn(&mf);
+
+    for (i = 0; i < mf.pos; i++) {
+        hash ^= (unsigned char)mf.buf[i];
+        hash *= 1099511628211ULL;
+    }
+    mfree(&mf);
+    return hash;
+}
+
+
+static void
+restore_pregen_state(struct memfile *mf)
+{
+    restore_mt_state(mf);
+    restore_rndmonst_state(mf);
+    restore_artifacts(mf);
+    free_branches();
+    restore_dungeon(mf);
+    mread(mf, mvitals, sizeof (mvitals));
+    mread(mf, &quest_status, sizeof (quest_status));
+    timer_id = mread32(mf);
+    flags.ident = mread32(mf);
+    flags.no_of_wizards = mread32(mf);
+    flags.djinni_count = mread32(mf);
+    flags.ghost_count = mread32(mf);
+    flags.made_amulet = mread8(mf);
+}
+
+
+/* the worker's half of pregen_take_level(); doesn't return */
+static void NORETURN
+worker_make_level(d_level * newlevel)
+{
+    struct memfile mf;
+    unsigned long long prehash, posthash;
+    xchar ledger = ledger_no(newlevel);
+    unsigned int len;
+    long written;
+    int n;
+
+    prehash = level_inputs_hash();
+
+    mnew(&msgbuf, NULL);
+    msgcount = 0;
+    capture_msgs = TRUE;
+    mklev(newlevel);
+    capture_msgs = FALSE;
+    posthash = level_inputs_hash();
+
+    mnew(&mf, NULL);
+    mwrite32(&mf, PREGEN_MAGIC);
+    mwrite8(&mf, ledger);
+    mwrite32(&mf, prehash & 0xffffffff);
+    mwrite32(&mf, prehash >> 32);
+    mwrite32(&mf, posthash & 0xffffffff);
+    mwrite32(&mf, posthash >> 32);
+
+    mwrite32(&mf, msgcount);
+    mwrite(&mf, msgbuf.buf, msgbuf.pos);
+
+    savelev(&mf, ledger);
+    save_pregen_state(&mf);
+
+    len = mf.pos;
+    if (write(worker_fd, &len, sizeof (len)) != sizeof (len))
+        _exit(1);
+    for (written = 0; written < len; written += n) {
+        n = write(worker_fd, mf.buf + written, len - written);
+        if (n <= 0)
+            _exit(1);
+    }
+    _exit(0);
+}
+
+
+/* read everything the worker sent; returns FALSE if it sent nothing usable */
+static boolean
+read_worker_result(struct memfile *mf)
+{
+    unsigned int len;
+    long got;
+    int n;
+
+    if (read(worker_fd, &len, sizeof (len)) != sizeof (len))
+        return FALSE;
+
+    mnew(mf, NULL);
+    mf->buf = malloc(len);
+    mf->len = len;
+    for (got = 0; got < len; got += n) {
+        n = read(worker_fd, mf->buf + got, len - got);
+        if (n <= 0) {
+            mfree(mf);
+            return FALSE;
+        }
+    }
+    mf->pos = 0;
+    return TRUE;
+}
+
+
+/* Install the level the worker made for ledger, if it made it from the same
+   state the game is in now; returns NULL otherwise. */
+static struct level *
+use_worker_level(xchar ledger)
+{
+    struct memfile mf, undo;
+    unsigned long long prehash, posthash, hash;
+    struct level *lev;
+    char msg[BUFSZ];
+    int i, len, count, msgpos;
+    boolean ok;
+
+    hash = level_inputs_hash();
+    ok = read_worker_result(&mf);
+    pregen_discard();
+    if (!ok)
+        return NULL;
+
+    if (mread32(&mf) != PREGEN_MAGIC || mread8(&mf) != ledger) {
+        mfree(&mf);
+        return NULL;
+    }
+    prehash = (unsigned int)mread32(&mf);
+    prehash |= (unsigned long long)(unsigned int)mread32(&mf) << 32;
+    posthash = (unsigned int)mread32(&mf);
+    posthash |= (unsigned long long)(unsigned int)mread32(&mf) << 32;
+    if (prehash != hash) {
+        /* the game went somewhere else since the worker was started */
+        mfree(&mf);
+        return NULL;
+    }
+
+    /* the messages are shown once the result is known to be good */
+    msgpos = mf.pos;
+    count = mread32(&mf);
+    for (i = 0; i < count; i++) {
+        len = mread32(&mf);
+        mf.pos += len;
+    }
+
+    /* keep what the result replaces, in case it has to be undone */
+    mnew(&undo, NULL);
+    save_pregen_state(&undo);
+    undo.pos = 0;
+
+    lev = getlev(&mf, ledger, FALSE);
+    oinit(lev); /* gem probabilities aren't part of the level */
+    restore_pregen_state(&mf);
+
+    /* The worker made the level from the same state, so the game must now be
+       exactly what mklev() would have left.  If it isn't, using the level
+       would make the game differ from its replay; go back and let the caller
+       make the level itself. */
+    if (level_inputs_hash() != posthash) {
+        freelev(ledger);
+        restore_pregen_state(&undo);
+        mfree(&undo);
+        mfree(&mf);
+        return NULL;
+    }
+    mfree(&undo);
+
+    mf.pos = msgpos;
+    count = mread32(&mf);
+    for (i = 0; i < count; i++) {
+        len = mread32(&mf);
+        mread(&mf, msg, len);
+        msg[len] = '\0';
+        pline("%s", msg);
+    }
+    mfree(&mf);
+
+    return lev;
+}
+
+
+/* Called by goto_level() instead of mklev() when arriving on a level for the
+ * first time.  Returns the level made by a worker, or NULL if there is no
+ * usable one; the caller makes the level itself in that case.  In a worker,
+ * this is where the level is made and sent, and it doesn't return. */
+struct level *
+pregen_take_level(d_level * newlevel)
+{
+    xchar ledger = ledger_no(newlevel);
+    struct level *lev;
+
+    if (in_worker)
+        worker_make_level(newlevel);
+
+    if (worker_pid <= 0 || worker_ledger != ledger || level_exists(ledger))
+        return NULL;
+
+    /* this includes waiting for the worker, if it isn't done yet */
+    bench_start(BENCH_PREGEN_TAKE);
+    lev = use_worker_level(ledger);
+    bench_stop(BENCH_PREGEN_TAKE);
+    bench_count(lev ? BENCH_PREGEN_HITS : BENCH_PREGEN_MISSES, 1);
+    return lev;
+}
+
+#else /* !UNIX */
+
+void
+pregen_discard(void)
+{
+}
+
+void
+pregen_after_command(void)
+{
+}
+
+void
+pregen_worker_abort(void)
+{
+}
+
+struct level *
+pregen_take_level(d_level * newlevel)
+{
+    return NULL;
+}
+
+#endif
+
+/* pregen.c */
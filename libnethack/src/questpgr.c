@@ -9,7 +9,6 @@
 
 #include "qtext.h"
 
-#define QTEXT_FILE      "quest.dat"
 /* #define DEBUG *//* uncomment for debugging */
 
 static void Fread(void *, int, int, dlb *);
@@ -133,11 +133,11 @@ doread(struct obj *scroll)
         }
     }
     if (!seffects(scroll, &known)) {
-        if (!objects[scroll->otyp].oc_name_known) {
+        if (!objstate[scroll->otyp].oc_name_known) {
             if (known) {
                 makeknown(scroll->otyp);
                 more_experienced(0, 10);
-            } else if (!objects[scroll->otyp].oc_uname)
+            } else if (!objstate[scroll->otyp].oc_uname)
                 docall(scroll);
         }
         if (scroll->otyp != SCR_BLANK_PAPER)
@@ -189,9 +189,9 @@ is_chargeable(struct obj *obj)
     /* known && !uname is possible after amnesia/mind flayer */
     if (obj->oclass == RING_CLASS)
         return (boolean) ((objects[obj->otyp].oc_charged &&
-                           (objects[obj->otyp].oc_name_known || obj->known)) ||
-                          (objects[obj->otyp].oc_uname &&
-                           !objects[obj->otyp].oc_name_known));
+                           (objstate[obj->otyp].oc_name_known || obj->known)) ||
+                          (objstate[obj->otyp].oc_uname &&
+                           !objstate[obj->otyp].oc_name_known));
     if (is_weptool(obj))        /* specific check before general tools */
         return FALSE;
 
@@ -458,13 +458,13 @@ forget_single_object(int obj_id)
     char *knownname;
     char *new_uname;
 
-    if (!objects[obj_id].oc_name_known)
+    if (!objstate[obj_id].oc_name_known)
         return; /* nothing to do */
     knownname = simple_typename(obj_id);
-    objects[obj_id].oc_name_known = 0;
-    if (objects[obj_id].oc_uname) {
-        free(objects[obj_id].oc_uname);
-        objects[obj_id].oc_uname = 0;
+    objstate[obj_id].oc_name_known = 0;
+    if (objstate[obj_id].oc_uname) {
+        free(objstate[obj_id].oc_uname);
+        objstate[obj_id].oc_uname = 0;
     }
     undiscover_object(obj_id);  /* after clearing oc_name_known */
 
@@ -472,7 +472,7 @@ forget_single_object(int obj_id)
        an interface screw. (In other words, we're formally-unIDing objects, but 
        not forcing the player to write down what they were. */
     new_uname = strcpy(malloc((unsigned)strlen(knownname) + 1), knownname);
-    objects[obj_id].oc_uname = new_uname;
+    objstate[obj_id].oc_uname = new_uname;
     discover_object(obj_id, FALSE, TRUE, FALSE);
 }
 
@@ -508,7 +508,7 @@ forget_objects(int percent)
     }
 
     for (count = 0, i = 1; i < NUM_OBJECTS; i++)
-        if (OBJ_DESCR(objects[i]) && (objects[i].oc_name_known))
+        if (OBJ_DESCR(i) && (objstate[i].oc_name_known))
             indices[count++] = i;
 
     randomize(indices, count);
@@ -1001,7 +1001,7 @@ seffects(struct obj *sobj, boolean * known)
                 ++cval;
         } else
             cval = 1;
-        if (!objects[sobj->otyp].oc_name_known)
+        if (!objstate[sobj->otyp].oc_name_known)
             more_experienced(0, 10);
         useup(sobj);
         makeknown(SCR_IDENTIFY);
@@ -1024,7 +1024,7 @@ seffects(struct obj *sobj, boolean * known)
         pline("This is a charging scroll.");
 
         cval = sobj->cursed ? -1 : (sobj->blessed ? 1 : 0);
-        if (!objects[sobj->otyp].oc_name_known)
+        if (!objstate[sobj->otyp].oc_name_known)
             more_experienced(0, 10);
         useup(sobj);
         makeknown(SCR_CHARGING);
@@ -1093,7 +1093,7 @@ seffects(struct obj *sobj, boolean * known)
          * some damage under all potential cases.
          */
         cval = bcsign(sobj);
-        if (!objects[sobj->otyp].oc_name_known)
+        if (!objstate[sobj->otyp].oc_name_known)
             more_experienced(0, 10);
         useup(sobj);
         makeknown(SCR_FIRE);
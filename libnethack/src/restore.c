@@ -640,18 +640,15 @@ dorecover_fd(int infd)
     struct memfile mf;
     long initial_pos;
 
-    mnew(&mf, NULL);
-
     restoring = TRUE;
 
     initial_pos = lseek(infd, 0, SEEK_CUR);
-    mf.buf = loadfile(infd, &mf.len);
-    if (!mf.buf)
+    if (!mmapfd(&mf, infd))
         return 0;
 
     ret = dorecover(&mf);
 
-    mfree(&mf);
+    mfree(&mf); /* unmaps the file, so it's safe to truncate it */
 
     if (ret) {
         /* erase the binary portion of the logfile */
@@ -674,83 +671,68 @@ trickery(char *reason)
 }
 
 
+/* The inverse of saved_mem_bg in save.c: for each saved mem_bg, the real
+   mem_bg and mem_door_t << 1 | mem_door_l. */
+static unsigned char restored_mem_bg[64], restored_door_lt[64];
+static boolean restored_mem_bg_ready = FALSE;
+
 static void
-restore_location(struct memfile *mf, struct rm *loc)
+init_restored_mem_bg(void)
 {
-    unsigned int lflags1;
-    unsigned short lflags2;
-    int l = 0, t = 0;
-
-    lflags1 = mread32(mf);
-    loc->typ = mread8(mf);
-    loc->seenv = mread8(mf);
-    lflags2 = mread16(mf);
-    loc->mem_bg = (lflags1 >> 26) & 63;
-    loc->mem_trap = (lflags1 >> 21) & 31;
-    loc->mem_obj = (lflags1 >> 11) & 1023;
-    loc->mem_obj_mn = (lflags1 >> 2) & 511;
-    loc->mem_invis = (lflags1 >> 1) & 1;
-    loc->mem_stepped = (lflags1 >> 0) & 1;
-    loc->flags = (lflags2 >> 11) & 31;
-    loc->horizontal = (lflags2 >> 10) & 1;
-    loc->lit = (lflags2 >> 9) & 1;
-    loc->waslit = (lflags2 >> 8) & 1;
-    loc->roomno = (lflags2 >> 2) & 63;
-    loc->edge = (lflags2 >> 1) & 1;
-
-    /* unpack mem_door_l, mem_door_t from mem_bg */
-    switch (loc->mem_bg) {
-    case S_vodoor_memlt:
-        loc->mem_bg = S_vodoor;
-        l = t = 1;
-        break;
-    case S_vodoor_meml:
-        loc->mem_bg = S_vodoor;
-        l = 1;
-        break;
-    case S_vodoor_memt:
-        loc->mem_bg = S_vodoor;
-        t = 1;
-        break;
-    case S_hodoor_memlt:
-        loc->mem_bg = S_hodoor;
-        l = t = 1;
-        break;
-    case S_hodoor_meml:
-        loc->mem_bg = S_hodoor;
-        l = 1;
-        break;
-    case S_hodoor_memt:
-        loc->mem_bg = S_hodoor;
-        t = 1;
-        break;
-    case S_vcdoor_memlt:
-        loc->mem_bg = S_vcdoor;
-        l = t = 1;
-        break;
-    case S_vcdoor_meml:
-        loc->mem_bg = S_vcdoor;
-        l = 1;
-        break;
-    case S_vcdoor_memt:
-        loc->mem_bg = S_vcdoor;
-        t = 1;
-        break;
-    case S_hcdoor_memlt:
-        loc->mem_bg = S_hcdoor;
-        l = t = 1;
-        break;
-    case S_hcdoor_meml:
-        loc->mem_bg = S_hcdoor;
-        l = 1;
-        break;
-    case S_hcdoor_memt:
-        loc->mem_bg = S_hcdoor;
-        t = 1;
-        break;
+    int bg;
+
+    for (bg = 0; bg < 64; bg++) {
+        if (bg >= S_vodoor_meml && bg <= S_hcdoor_memlt) {
+            restored_mem_bg[bg] = S_vodoor + (bg - S_vodoor_meml) / 3;
+            restored_door_lt[bg] = (bg - S_vodoor_meml) % 3 + 1;
+        } else {
+            restored_mem_bg[bg] = bg;
+            restored_door_lt[bg] = 0;
+        }
     }
-    loc->mem_door_l = l;
-    loc->mem_door_t = t;
+    restored_mem_bg_ready = TRUE;
+}
+
+
+/* Read the whole location grid at once and decode it. */
+static void
+restore_locations(struct memfile *mf, struct level *lev)
+{
+    unsigned char buf[COLNO * ROWNO * SAVED_LOCATION_SIZE], *p = buf;
+    unsigned int lflags1, lflags2, bg;
+    struct rm *loc;
+    int x, y;
+
+    if (!restored_mem_bg_ready)
+        init_restored_mem_bg();
+
+    mread(mf, buf, sizeof (buf));
+
+    for (x = 0; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++, p += SAVED_LOCATION_SIZE) {
+            loc = &lev->locations[x][y];
+            lflags1 = p[0] | (p[1] << 8) | (p[2] << 16) |
+                ((unsigned int)p[3] << 24);
+            loc->typ = (int8_t)p[4];
+            loc->seenv = p[5];
+            lflags2 = p[6] | (p[7] << 8);
+
+            bg = (lflags1 >> 26) & 63;
+            loc->mem_bg = restored_mem_bg[bg];
+            loc->mem_door_l = restored_door_lt[bg] & 1;
+            loc->mem_door_t = restored_door_lt[bg] >> 1;
+            loc->mem_trap = (lflags1 >> 21) & 31;
+            loc->mem_obj = (lflags1 >> 11) & 1023;
+            loc->mem_obj_mn = (lflags1 >> 2) & 511;
+            loc->mem_invis = (lflags1 >> 1) & 1;
+            loc->mem_stepped = (lflags1 >> 0) & 1;
+            loc->flags = (lflags2 >> 11) & 31;
+            loc->horizontal = (lflags2 >> 10) & 1;
+            loc->lit = (lflags2 >> 9) & 1;
+            loc->waslit = (lflags2 >> 8) & 1;
+            loc->roomno = (lflags2 >> 2) & 63;
+            loc->edge = (lflags2 >> 1) & 1;
+        }
 }
 
 
@@ -821,9 +803,7 @@ getlev(struct memfile *mf, xchar levnum, boolean ghostly)
     lev->z.dnum = mread8(mf);
     lev->z.dlevel = mread8(mf);
     mread(mf, lev->levname, sizeof (lev->levname));
-    for (x = 0; x < COLNO; x++)
-        for (y = 0; y < ROWNO; y++)
-            restore_location(mf, &lev->locations[x][y]);
+    restore_locations(mf, lev);
 
     lev->lastmoves = mread32(mf);
     mread(mf, &lev->upstair, sizeof (stairway));
@@ -902,6 +882,7 @@ getlev(struct memfile *mf, xchar levnum, boolean ghostly)
     for (x = 0; x < COLNO; x++)
         for (y = 0; y < ROWNO; y++)
             lev->monsters[x][y] = NULL;
+    memset(lev->monbits, 0, sizeof (lev->monbits));
     for (mtmp = lev->monlist; mtmp; mtmp = mtmp->nmon) {
         if (mtmp->isshk)
             set_residency(mtmp, FALSE);
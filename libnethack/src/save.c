@@ -86,21 +86,45 @@ dosave0(boolean emergency)
 }
 
 
+/* Place flags, player info & moves at the beginning of the save. This makes
+   it possible to read them in nh_get_savegame_status without parsing all the
+   dungeon and level data */
 void
-savegame(struct memfile *mf)
+save_header(struct memfile *mf)
 {
-    int count = 0;
-    xchar ltmp;
-
     /* no tag useful here as store_version adds one */
     store_version(mf);
 
-    /* Place flags, player info & moves at the beginning of the save. This
-       makes it possible to read them in nh_get_savegame_status without parsing 
-       all the dungeon and level data */
     save_flags(mf);
     save_you(mf, &u);
     mwrite32(mf, moves);        /* no tag useful here; you is fixed-length */
+}
+
+
+/* The length of what save_header writes. None of it is variable-length, so
+   it's the same for every save. */
+int
+savegame_header_size(void)
+{
+    struct memfile mf;
+    int len;
+
+    mnew(&mf, NULL);
+    save_header(&mf);
+    len = mf.pos;
+    mfree(&mf);
+
+    return len;
+}
+
+
+void
+savegame(struct memfile *mf)
+{
+    int count = 0;
+    xchar ltmp;
+
+    save_header(mf);
     save_mon(mf, &youmonst);
 
     /* store dungeon layout */
@@ -110,15 +134,18 @@ savegame(struct memfile *mf)
     /* store levels */
     mtag(mf, 0, MTAG_LEVELS);
     for (ltmp = 1; ltmp <= maxledgerno(); ltmp++)
-        if (levels[ltmp])
+        if (level_exists(ltmp))
             count++;
     mwrite32(mf, count);
     for (ltmp = 1; ltmp <= maxledgerno(); ltmp++) {
-        if (!levels[ltmp])
+        if (!level_exists(ltmp))
             continue;
         mtag(mf, ltmp, MTAG_LEVELS);
         mwrite8(mf, ltmp);      /* level number */
-        savelev(mf, ltmp);      /* actual level */
+        if (level_is_cold(ltmp))
+            save_cold_level(mf, ltmp);
+        else
+            savelev(mf, ltmp);  /* actual level */
     }
     savegamestate(mf);
 }
@@ -278,66 +305,69 @@ savegamestate(struct memfile *mf)
 }
 
 
+/* mem_bg as it is saved, indexed by mem_bg << 2 | mem_door_t << 1 |
+   mem_door_l. For doors, the player's knowledge of the lock and trap is packed
+   into mem_bg using the S_*door_mem* values, which come in the same order as
+   the doors they belong to. */
+static unsigned char saved_mem_bg[64 * 4];
+static boolean saved_mem_bg_ready = FALSE;
+
 static void
-save_location(struct memfile *mf, struct rm *loc)
+init_saved_mem_bg(void)
 {
-    unsigned int memflags;
-    unsigned short rflags;
-
-    unsigned char bg = loc->mem_bg;
-
-    /* pack mem_door_l, mem_door_t into mem_bg */
-    switch (bg) {
-    case S_vodoor:
-        if (loc->mem_door_l && loc->mem_door_t)
-            bg = S_vodoor_memlt;
-        else if (loc->mem_door_l)
-            bg = S_vodoor_meml;
-        else if (loc->mem_door_t)
-            bg = S_vodoor_memt;
-        break;
-    case S_hodoor:
-        if (loc->mem_door_l && loc->mem_door_t)
-            bg = S_hodoor_memlt;
-        else if (loc->mem_door_l)
-            bg = S_hodoor_meml;
-        else if (loc->mem_door_t)
-            bg = S_hodoor_memt;
-        break;
-    case S_vcdoor:
-        if (loc->mem_door_l && loc->mem_door_t)
-            bg = S_vcdoor_memlt;
-        else if (loc->mem_door_l)
-            bg = S_vcdoor_meml;
-        else if (loc->mem_door_t)
-            bg = S_vcdoor_memt;
-        break;
-    case S_hcdoor:
-        if (loc->mem_door_l && loc->mem_door_t)
-            bg = S_hcdoor_memlt;
-        else if (loc->mem_door_l)
-            bg = S_hcdoor_meml;
-        else if (loc->mem_door_t)
-            bg = S_hcdoor_memt;
-        break;
-    }
+    int bg, lt;
+
+    for (bg = 0; bg < 64; bg++)
+        for (lt = 0; lt < 4; lt++)
+            saved_mem_bg[bg << 2 | lt] = (lt && bg >= S_vodoor &&
+                                          bg <= S_hcdoor) ?
+                S_vodoor_meml + (bg - S_vodoor) * 3 + lt - 1 : bg;
+    saved_mem_bg_ready = TRUE;
+}
+
+
+/* Encode the whole location grid into one buffer and write it at once. */
+static void
+save_locations(struct memfile *mf, struct level *lev)
+{
+    unsigned char buf[COLNO * ROWNO * SAVED_LOCATION_SIZE], *p = buf;
+    unsigned int memflags, rflags;
+    const struct rm *loc;
+    int x, y;
+
+    if (!saved_mem_bg_ready)
+        init_saved_mem_bg();
 
-    memflags = (bg << 26) | (loc->mem_trap << 21) | (loc->mem_obj << 11) |
-        (loc->mem_obj_mn << 2) | (loc->mem_invis << 1) |
-        (loc->mem_stepped << 0);
-    rflags = (loc->flags << 11) | (loc->horizontal << 10) | (loc->lit << 9) |
-        (loc->waslit << 8) | (loc->roomno << 2) | (loc->edge << 1);
-    mwrite32(mf, memflags);
-    mwrite8(mf, loc->typ);
-    mwrite8(mf, loc->seenv);
-    mwrite16(mf, rflags);
+    for (x = 0; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++, p += SAVED_LOCATION_SIZE) {
+            loc = &lev->locations[x][y];
+            memflags = ((unsigned int)
+                        saved_mem_bg[loc->mem_bg << 2 | loc->mem_door_t << 1 |
+                                     loc->mem_door_l] << 26) |
+                (loc->mem_trap << 21) | (loc->mem_obj << 11) |
+                (loc->mem_obj_mn << 2) | (loc->mem_invis << 1) |
+                (loc->mem_stepped << 0);
+            rflags = (loc->flags << 11) | (loc->horizontal << 10) |
+                (loc->lit << 9) | (loc->waslit << 8) | (loc->roomno << 2) |
+                (loc->edge << 1);
+
+            p[0] = memflags;
+            p[1] = memflags >> 8;
+            p[2] = memflags >> 16;
+            p[3] = memflags >> 24;
+            p[4] = loc->typ;
+            p[5] = loc->seenv;
+            p[6] = rflags;
+            p[7] = rflags >> 8;
+        }
+
+    mwrite(mf, buf, sizeof (buf));
 }
 
 
 void
 savelev(struct memfile *mf, xchar levnum)
 {
-    int x, y;
     unsigned int lflags;
     struct level *lev = levels[levnum];
 
@@ -357,9 +387,7 @@ savelev(struct memfile *mf, xchar levnum)
     mwrite8(mf, lev->z.dlevel);
     mwrite(mf, lev->levname, sizeof (lev->levname));
 
-    for (x = 0; x < COLNO; x++)
-        for (y = 0; y < ROWNO; y++)
-            save_location(mf, &lev->locations[x][y]);
+    save_locations(mf, lev);
 
     mwrite32(mf, lev->lastmoves);
     mwrite(mf, &lev->upstair, sizeof (stairway));
@@ -660,11 +688,14 @@ freedynamicdata(void)
     int i;
     struct level *lev;
 
-    if (!objects)
+    if (!objstate_valid)
         return; /* no cleanup necessary */
 
+    pregen_discard();
+    free_cold_levels();
     unload_qtlist();
     free_invbuf();      /* let_to_name (invent.c) */
+    free_invent_cache();        /* inventory names (invent.c) */
     free_youbuf();      /* You_buf,&c (pline.c) */
     tmpsym_freeall();    /* temporary display effects */
 #define free_animals()   mon_animal_list(FALSE)
@@ -709,15 +740,16 @@ freedynamicdata(void)
         free(iflags.ap_rules);
     }
     iflags.ap_rules = NULL;
-    free(artilist);
-    free(objects);
-    objects = NULL;
-    artilist = NULL;
+    reset_autopickup_matcher();
+    objstate_valid = FALSE;
 
     if (active_birth_options)
         free_optlist(active_birth_options);
     active_birth_options = NULL;
 
+    /* every object and monster is gone now */
+    slab_reset();
+
     return;
 }
 
@@ -173,7 +173,7 @@ void
 shkgone(struct monst *mtmp)
 {
     struct eshk *eshk = ESHK(mtmp);
-    struct level *shoplev = levels[ledger_no(&eshk->shoplevel)];
+    struct level *shoplev = level_by_ledger(ledger_no(&eshk->shoplevel));
     struct mkroom *sroom = &shoplev->rooms[eshk->shoproom - ROOMOFFSET];
     struct obj *otmp;
     char *p;
@@ -1694,7 +1694,8 @@ find_oid(unsigned id)
         if ((obj = o_on(id, mon->minvent)))
             return obj;
 
-    /* search all levels */
+    /* search all levels in memory; nothing refers to objects on a cold
+       level, so there's no point in restoring one */
     for (i = 0; i < maxledgerno(); i++)
         if (levels[i] && (obj = find_oid_lev(levels[i], id)))
             return obj;
@@ -1746,8 +1747,9 @@ get_cost(const struct obj *obj, struct monst *shkp)
         tmp = 5L;
     /* shopkeeper may notice if the player isn't very knowledgeable -
        especially when gem prices are concerned */
-    if (!obj->dknown || !objects[obj->otyp].oc_name_known) {
-        if (obj->oclass == GEM_CLASS && objects[obj->otyp].oc_material == GLASS) {
+    if (!obj->dknown || !objstate[obj->otyp].oc_name_known) {
+        if (obj->oclass == GEM_CLASS &&
+            objstate[obj->otyp].oc_material == GLASS) {
             int i;
 
             /* get a value that's 'random' from game to game, but the same
@@ -1925,11 +1927,11 @@ set_cost(struct obj *obj, struct monst *shkp)
 
     /* shopkeeper may notice if the player isn't very knowledgeable -
        especially when gem prices are concerned */
-    if (!obj->dknown || !objects[obj->otyp].oc_name_known) {
+    if (!obj->dknown || !objstate[obj->otyp].oc_name_known) {
         if (obj->oclass == GEM_CLASS) {
             /* different shop keepers give different prices */
-            if (objects[obj->otyp].oc_material == GEMSTONE ||
-                objects[obj->otyp].oc_material == GLASS) {
+            if (objstate[obj->otyp].oc_material == GEMSTONE ||
+                objstate[obj->otyp].oc_material == GLASS) {
                 tmp = (obj->otyp % (6 - shkp->m_id % 3));
                 tmp = (tmp + 3) * obj->quan;
             }
@@ -2055,7 +2057,7 @@ shk_names_obj(struct monst *shkp, struct obj *obj,
         (obj->oclass == WEAPON_CLASS || obj->oclass == ARMOR_CLASS ||
          obj->oclass == SCROLL_CLASS || obj->oclass == SPBOOK_CLASS ||
          obj->otyp == MIRROR)) {
-        was_unknown |= !objects[obj->otyp].oc_name_known;
+        was_unknown |= !objstate[obj->otyp].oc_name_known;
         makeknown(obj->otyp);
     }
     obj_name = doname(obj);
@@ -2847,7 +2849,8 @@ remove_damage(struct monst *shkp, boolean croaked)
     boolean saw_floor = FALSE, stop_picking = FALSE;
     boolean saw_untrap = FALSE;
     uchar saw_walls = 0;
-    struct level *lev = levels[ledger_no(&ESHK(shkp)->shoplevel)];
+    struct level *lev =
+        level_by_ledger(ledger_no(&ESHK(shkp)->shoplevel));
 
     tmp_dam = lev->damagelist;
     tmp2_dam = 0;
@@ -3546,7 +3549,7 @@ shk_embellish(struct obj *itm, long cost)
                 o = itm->oclass;
             if (o == FOOD_CLASS)
                 return ", gourmets' delight!";
-            if (objects[itm->otyp].oc_name_known ? objects[itm->otyp].
+            if (objstate[itm->otyp].oc_name_known ? objects[itm->otyp].
                 oc_magic : (o == AMULET_CLASS || o == RING_CLASS ||
                             o == WAND_CLASS || o == POTION_CLASS ||
                             o == SCROLL_CLASS || o == SPBOOK_CLASS))
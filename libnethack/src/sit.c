@@ -64,7 +64,7 @@ dosit(void)
 
         obj = level->objects[u.ux][u.uy];
         pline("You sit on %s.", the(xname(obj)));
-        if (!(Is_box(obj) || objects[obj->otyp].oc_material == CLOTH))
+        if (!(Is_box(obj) || objstate[obj->otyp].oc_material == CLOTH))
             pline("It's not very comfortable...");
 
     } else if ((trap = t_at(level, u.ux, u.uy)) != 0 ||
@@ -0,0 +1,184 @@
+/* vim:set cin ft=c sw=4 sts=4 ts=8 et ai cino=Ls\:0t0(0 : -*- mode:c;fill-column:80;tab-width:8;c-basic-offset:4;indent-tabs-mode:nil;c-file-style:"k&r" -*-*/
+/* NetHack may be freely redistributed.  See license for details. */
+
+/* Pooled allocation for objects and monsters.
+ *
+ * Objects and monsters are created and destroyed in large numbers, most of all
+ * when levels and replay checkpoints are restored.  Instead of going to malloc
+ * for each of them, they are carved out of large chunks with one set of chunks
+ * per size class (the size includes the variable-length oextra/mextra tail),
+ * and freed ones go onto a free list for their class.
+ *
+ * slab_reset() makes every chunk available again in one go; it is used when
+ * all game data is discarded, so that a following restore can reuse the same
+ * memory.  Allocations larger than the largest class (e.g. shopkeepers) are
+ * passed through to malloc. */
+
+#include "hack.h"
+
+#define SLAB_GRANULE    16
+#define SLAB_CLASSES    32      /* classes are 16, 32, ... 512 bytes */
+#define SLAB_CHUNK_SIZE 16384
+#define SLAB_LARGE      (-1)
+
+/* placed in front of every allocation; the union keeps the payload aligned
+   for any of the structures allocated here */
+union slab_header {
+    int sclass;
+    union slab_header *next_free;
+    void *align_ptr;
+    long align_long;
+    double align_double;
+};
+
+struct slab_chunk {
+    struct slab_chunk *next;
+    size_t used;        /* bytes handed out so far */
+    union slab_header data[];
+};
+
+struct slab_class {
+    struct slab_chunk *chunks;  /* all chunks of this class, oldest first */
+    struct slab_chunk *current; /* the chunk new entries are carved from */
+    union slab_header *free_list;
+};
+
+static struct slab_class slab_classes[SLAB_CLASSES];
+
+
+static size_t
+slab_entry_size(int sclass)
+{
+    return sizeof (union slab_header) + (sclass + 1) * SLAB_GRANULE;
+}
+
+
+static size_t
+slab_chunk_capacity(int sclass)
+{
+    size_t esize = slab_entry_size(sclass);
+
+    return (SLAB_CHUNK_SIZE / esize) * esize;
+}
+
+
+static union slab_header *
+slab_carve(int sclass)
+{
+    struct slab_class *sc = &slab_classes[sclass];
+    size_t esize = slab_entry_size(sclass);
+    size_t capacity = slab_chunk_capacity(sclass);
+    struct slab_chunk *chunk;
+    union slab_header *entry;
+
+    /* after slab_reset() the chunks after current are empty again */
+    while (sc->current && sc->current->used + esize > capacity)
+        sc->current = sc->current->next;
+
+    if (!sc->current) {
+        chunk = malloc(sizeof (struct slab_chunk) + capacity);
+        if (!chunk)
+            panic("slab_alloc: out of memory");
+        chunk->next = NULL;
+        chunk->used = 0;
+        if (sc->chunks) {
+            struct slab_chunk *last = sc->chunks;
+
+            while (last->next)
+                last = last->next;
+            last->next = chunk;
+        } else
+            sc->chunks = chunk;
+        sc->current = chunk;
+    }
+
+    entry = (union slab_header *)((char *)sc->current->data +
+                                  sc->current->used);
+    sc->current->used += esize;
+    return entry;
+}
+
+
+void *
+slab_alloc(size_t size)
+{
+    union slab_header *entry;
+    int sclass;
+
+    sclass = size ? (size - 1) / SLAB_GRANULE : 0;
+    if (sclass >= SLAB_CLASSES) {
+        entry = malloc(sizeof (union slab_header) + size);
+        if (!entry)
+            panic("slab_alloc: out of memory");
+        entry->sclass = SLAB_LARGE;
+        return entry + 1;
+    }
+
+    entry = slab_classes[sclass].free_list;
+    if (entry)
+        slab_classes[sclass].free_list = entry->next_free;
+    else
+        entry = slab_carve(sclass);
+
+    entry->sclass = sclass;
+    return entry + 1;
+}
+
+
+void
+slab_free(void *ptr)
+{
+    union slab_header *entry;
+    int sclass;
+
+    if (!ptr)
+        return;
+
+    entry = (union slab_header *)ptr - 1;
+    sclass = entry->sclass;
+    if (sclass == SLAB_LARGE) {
+        free(entry);
+        return;
+    }
+
+    entry->next_free = slab_classes[sclass].free_list;
+    slab_classes[sclass].free_list = entry;
+}
+
+
+/* Forget about everything allocated from the chunks, but keep the chunks.
+   Nothing that was allocated by slab_alloc may be used afterwards. */
+void
+slab_reset(void)
+{
+    int i;
+    struct slab_chunk *chunk;
+
+    for (i = 0; i < SLAB_CLASSES; i++) {
+        for (chunk = slab_classes[i].chunks; chunk; chunk = chunk->next)
+            chunk->used = 0;
+        slab_classes[i].current = slab_classes[i].chunks;
+        slab_classes[i].free_list = NULL;
+    }
+}
+
+
+/* give the chunks back to the system */
+void
+slab_release(void)
+{
+    int i;
+    struct slab_chunk *chunk;
+
+    for (i = 0; i < SLAB_CLASSES; i++) {
+        while (slab_classes[i].chunks) {
+            chunk = slab_classes[i].chunks;
+            slab_classes[i].chunks = chunk->next;
+            free(chunk);
+        }
+        slab_classes[i].current = NULL;
+        slab_classes[i].free_list = NULL;
+    }
+}
+
+/* slab.c */
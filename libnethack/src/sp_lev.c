@@ -851,8 +851,8 @@ create_monster(struct level *lev, monster * m, struct mkroom *croom)
 
                 case M_AP_OBJECT:
                     for (i = 0; i < NUM_OBJECTS; i++)
-                        if (OBJ_NAME(objects[i]) &&
-                            !strcmp(OBJ_NAME(objects[i]), m->appear_as.str))
+                        if (OBJ_NAME(i) &&
+                            !strcmp(OBJ_NAME(i), m->appear_as.str))
                             break;
                     if (i == NUM_OBJECTS) {
                         impossible("create_monster: can't find object \"%s\"",
@@ -15,7 +15,7 @@ static schar delay;     /* moves left for this spell */
 #define incrnknow(spell)        spl_book[spell].sp_know = KEEN
 
 #define spellev(spell)          spl_book[spell].sp_lev
-#define spellname(spell)        OBJ_NAME(objects[spellid(spell)])
+#define spellname(spell)        OBJ_NAME(spellid(spell))
 #define spellet(spell)  \
         ((char)((spell < 26) ? ('a' + spell) : ('A' + spell - 26)))
 
@@ -169,8 +169,8 @@ confused_book(struct obj *spellbook)
             ("Being confused you have difficulties in controlling your actions.");
         win_pause_output(P_MESSAGE);
         pline("You accidentally tear the spellbook to pieces.");
-        if (!objects[spellbook->otyp].oc_name_known &&
-            !objects[spellbook->otyp].oc_uname)
+        if (!objstate[spellbook->otyp].oc_name_known &&
+            !objstate[spellbook->otyp].oc_uname)
             docall(spellbook);
         useup(spellbook);
         gone = TRUE;
@@ -336,8 +336,8 @@ learn(void)
     }
 
     sprintf(splname,
-            objects[booktype].oc_name_known ? "\"%s\"" : "the \"%s\" spell",
-            OBJ_NAME(objects[booktype]));
+            objstate[booktype].oc_name_known ? "\"%s\"" : "the \"%s\" spell",
+            OBJ_NAME(booktype));
     for (i = 0; i < MAXSPELL; i++) {
         if (spellid(i) == booktype) {
             if (book->spestudied > MAX_SPELL_STUDY) {
@@ -469,8 +469,8 @@ study_book(struct obj *spellbook)
             if (gone || !rn2(3)) {
                 if (!gone)
                     pline("The spellbook crumbles to dust!");
-                if (!objects[spellbook->otyp].oc_name_known &&
-                    !objects[spellbook->otyp].oc_uname)
+                if (!objstate[spellbook->otyp].oc_name_known &&
+                    !objstate[spellbook->otyp].oc_uname)
                     docall(spellbook);
                 useup(spellbook);
             } else
@@ -1220,7 +1220,7 @@ initialspell(struct obj *obj)
     for (i = 0; i < MAXSPELL; i++) {
         if (spellid(i) == obj->otyp) {
             pline("Error: Spell %s already known.",
-                  OBJ_NAME(objects[obj->otyp]));
+                  OBJ_NAME(obj->otyp));
             return;
         }
         if (spellid(i) == NO_SPELL) {
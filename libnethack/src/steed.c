@@ -121,11 +121,11 @@ use_saddle(struct obj *otmp)
     }
     if (Confusion || Fumbling || Glib)
         chance -= 20;
-    else if (uarmg && (s = OBJ_DESCR(objects[uarmg->otyp])) != NULL &&
+    else if (uarmg && (s = OBJ_DESCR(uarmg->otyp)) != NULL &&
              !strncmp(s, "riding ", 7))
         /* Bonus for wearing "riding" (but not fumbling) gloves */
         chance += 10;
-    else if (uarmf && (s = OBJ_DESCR(objects[uarmf->otyp])) != NULL &&
+    else if (uarmf && (s = OBJ_DESCR(uarmf->otyp)) != NULL &&
              !strncmp(s, "riding ", 7))
         /* ... or for "riding boots" */
         chance += 10;
@@ -625,6 +625,7 @@ place_monster(struct monst *mon, int x, int y)
     mon->mx = x;
     mon->my = y;
     mon->dlevel->monsters[x][y] = mon;
+    set_monbit(mon->dlevel, x, y);
 }
 
 /*steed.c*/
@@ -55,7 +55,7 @@ burnarmor(struct monst *victim)
         case 0:
             item = (victim == &youmonst) ? uarmh : which_armor(victim, W_ARMH);
             if (item) {
-                mat_idx = objects[item->otyp].oc_material;
+                mat_idx = objstate[item->otyp].oc_material;
                 sprintf(buf, "%s %s", materialnm[mat_idx], helmet_name(item));
             }
             if (!burn_dmg(item, item ? buf : "helmet"))
@@ -510,7 +510,7 @@ static void
 knows_object(int obj)
 {
     discover_object(obj, TRUE, FALSE, FALSE);
-    objects[obj].oc_pre_discovered = 1; /* not a "discovery" */
+    objstate[obj].oc_pre_discovered = 1; /* not a "discovery" */
 }
 
 /* Know ordinary (non-magical) objects of a certain class,
@@ -1026,7 +1026,7 @@ ini_inv(const struct trobj *trop, short nocreate[4])
         obj = addinv(obj);
 
         /* Make the type known if necessary */
-        if (OBJ_DESCR(objects[otyp]) && obj->known)
+        if (OBJ_DESCR(otyp) && obj->known)
             knows_object(otyp);
 
         /* pre-ID oil as it's easy to check anyway */
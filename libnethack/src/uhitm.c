@@ -629,9 +629,9 @@ hmon_hitmon(struct monst *mon, struct obj *obj, int thrown)
         /* So do silver rings.  Note: rings are worn under gloves, so you don't 
            get both bonuses. */
         if (!uarmg) {
-            if (uleft && objects[uleft->otyp].oc_material == SILVER)
+            if (uleft && objstate[uleft->otyp].oc_material == SILVER)
                 barehand_silver_rings++;
-            if (uright && objects[uright->otyp].oc_material == SILVER)
+            if (uright && objstate[uright->otyp].oc_material == SILVER)
                 barehand_silver_rings++;
             if (barehand_silver_rings && hates_silver(mdat)) {
                 tmp += rnd(20);
@@ -661,7 +661,7 @@ hmon_hitmon(struct monst *mon, struct obj *obj, int thrown)
                 /* need to duplicate this check for silver arrows: they aren't
                    caught below as they're weapons, and aren't caught in dmgval 
                    as they aren't melee weapons. */
-                if (objects[obj->otyp].oc_material == SILVER &&
+                if (objstate[obj->otyp].oc_material == SILVER &&
                     hates_silver(mdat)) {
                     silvermsg = TRUE;
                     silverobj = TRUE;
@@ -733,7 +733,7 @@ hmon_hitmon(struct monst *mon, struct obj *obj, int thrown)
                         return TRUE;
                     hittxt = TRUE;
                 }
-                if (objects[obj->otyp].oc_material == SILVER &&
+                if (objstate[obj->otyp].oc_material == SILVER &&
                     hates_silver(mdat)) {
                     silvermsg = TRUE;
                     silverobj = TRUE;
@@ -974,7 +974,7 @@ hmon_hitmon(struct monst *mon, struct obj *obj, int thrown)
                      * Things like silver wands can arrive here so
                      * so we need another silver check.
                      */
-                    if (objects[obj->otyp].oc_material == SILVER &&
+                    if (objstate[obj->otyp].oc_material == SILVER &&
                         hates_silver(mdat)) {
                         tmp += rnd(20);
                         silvermsg = TRUE;
@@ -1104,7 +1104,7 @@ hmon_hitmon(struct monst *mon, struct obj *obj, int thrown)
         monflee(mon, 10 * rnd(tmp), FALSE, FALSE);
     }
     if ((mdat == &mons[PM_BLACK_PUDDING] || mdat == &mons[PM_BROWN_PUDDING])
-        && obj && obj == uwep && objects[obj->otyp].oc_material == IRON &&
+        && obj && obj == uwep && objstate[obj->otyp].oc_material == IRON &&
         mon->mhp > 1 && !thrown && !mon->mcan
         /* && !destroyed -- guaranteed by mhp > 1 */ ) {
         if (clone_mon(mon, 0, 0)) {
@@ -1191,7 +1191,7 @@ shade_aware(struct obj *obj)
         obj->otyp == IRON_CHAIN /* dmgval handles those first three */
         || obj->otyp == MIRROR  /* silver in the reflective surface */
         || obj->otyp == CLOVE_OF_GARLIC /* causes shades to flee */
-        || objects[obj->otyp].oc_material == SILVER)
+        || objstate[obj->otyp].oc_material == SILVER)
         return TRUE;
     return FALSE;
 }
@@ -1226,8 +1226,8 @@ m_slips_free(struct monst *mdef, const struct attack *mattk)
               /* avoid "slippery slippery cloak" for undiscovered oilskin cloak 
                */
               (obj->greased ||
-               objects[obj->otyp].
-               oc_name_known) ? xname(obj) : cloak_simple_name(obj));
+               objstate[obj->otyp].oc_name_known) ? xname(obj) :
+              cloak_simple_name(obj));
 
         if (obj->greased && !rn2(2)) {
             pline("The grease wears off.");
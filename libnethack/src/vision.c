@@ -503,6 +503,8 @@ vision_recalc(int control)
     if (in_mklev || !iflags.vision_inited)
         return;
 
+    bench_start(BENCH_VISION);
+
     /* 
      * Either the light sources have been taken care of, or we must
      * recalculate them here.
@@ -807,6 +809,8 @@ skip:
     /* Set the new min and max pointers. */
     viz_rmin = next_rmin;
     viz_rmax = next_rmax;
+
+    bench_stop(BENCH_VISION);
 }
 
 
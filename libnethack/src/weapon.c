@@ -9,7 +9,7 @@
  */
 #include "hack.h"
 
-/* Categories whose names don't come from OBJ_NAME(objects[type])
+/* Categories whose names don't come from OBJ_NAME(type)
  */
 #define PN_BARE_HANDED       (-1)    /* includes martial arts */
 #define PN_TWO_WEAPONS       (-2)
@@ -87,7 +87,7 @@ static char *skill_level_name(int, char *);
 static void skill_advance(int);
 
 #define P_NAME(type) ((skill_names_indices[type] > 0) ? \
-                      OBJ_NAME(objects[skill_names_indices[type]]) : \
+                      OBJ_NAME(skill_names_indices[type]) : \
                       (type == P_BARE_HANDED_COMBAT) ? \
                         barehands_or_martial[martial_bonus()] : \
                         odd_skill_names[-skill_names_indices[type]])
@@ -264,10 +264,10 @@ dmgval(struct obj *otmp, struct monst *mon)
             tmp = 0;
     }
 
-    if (objects[otyp].oc_material <= LEATHER && thick_skinned(ptr))
+    if (objstate[otyp].oc_material <= LEATHER && thick_skinned(ptr))
         /* thick skinned/scaled creatures don't feel it */
         tmp = 0;
-    if (ptr == &mons[PM_SHADE] && objects[otyp].oc_material != SILVER)
+    if (ptr == &mons[PM_SHADE] && objstate[otyp].oc_material != SILVER)
         tmp = 0;
 
     /* "very heavy iron ball"; weight increase is in increments of 160 */
@@ -291,7 +291,7 @@ dmgval(struct obj *otmp, struct monst *mon)
             bonus += rnd(4);
         if (is_axe(otmp) && is_wooden(ptr))
             bonus += rnd(4);
-        if (objects[otyp].oc_material == SILVER && hates_silver(ptr))
+        if (objstate[otyp].oc_material == SILVER && hates_silver(ptr))
             bonus += rnd(20);
 
         /* if the weapon is going to get a double damage bonus, adjust this
@@ -379,7 +379,8 @@ would_prefer_rwep(struct monst *mtmp, struct obj *otmp)
 
     if (((strongmonst(mtmp->data) && (mtmp->misc_worn_check & W_ARMS) == 0)
          || !objects[pwep[i]].oc_bimanual) &&
-        (objects[pwep[i]].oc_material != SILVER || !hates_silver(mtmp->data))) {
+        (objstate[pwep[i]].oc_material != SILVER ||
+         !hates_silver(mtmp->data))) {
         for (i = 0; i < SIZE(pwep); i++) {
             if (wep && wep->otyp == pwep[i] &&
                 !(otmp->otyp == pwep[i] &&
@@ -439,7 +440,7 @@ select_rwep(struct monst *mtmp)
             if (((strongmonst(mtmp->data) &&
                   (mtmp->misc_worn_check & W_ARMS) == 0)
                  || !objects[pwep[i]].oc_bimanual) &&
-                (objects[pwep[i]].oc_material != SILVER ||
+                (objstate[pwep[i]].oc_material != SILVER ||
                  !hates_silver(mtmp->data))) {
                 if ((otmp = oselect(mtmp, pwep[i])) != 0) {
                     propellor = otmp;   /* force the monster to wield it */
@@ -599,7 +600,7 @@ select_hwep(struct monst *mtmp)
             continue;
         if (((strong && !wearing_shield)
              || !objects[hwep[i]].oc_bimanual) &&
-            (objects[hwep[i]].oc_material != SILVER ||
+            (objstate[hwep[i]].oc_material != SILVER ||
              !hates_silver(mtmp->data)))
             Oselect(hwep[i]);
     }
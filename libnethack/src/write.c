@@ -122,12 +122,12 @@ dowrite(struct obj *pen)
     last = bases[(int)paper->oclass + 1] - 1;
     for (i = first; i <= last; i++) {
         /* extra shufflable descr not representing a real object */
-        if (!OBJ_NAME(objects[i]))
+        if (!OBJ_NAME(i))
             continue;
 
-        if (!strcmpi(OBJ_NAME(objects[i]), nm))
+        if (!strcmpi(OBJ_NAME(i), nm))
             goto found;
-        if (!strcmpi(OBJ_DESCR(objects[i]), nm)) {
+        if (!strcmpi(OBJ_DESCR(i), nm)) {
             by_descr = TRUE;
             goto found;
         }
@@ -145,7 +145,7 @@ found:
         pline("No mere dungeon adventurer could write that.");
         return 1;
     } else if (by_descr && paper->oclass == SPBOOK_CLASS &&
-               !objects[i].oc_name_known) {
+               !objstate[i].oc_name_known) {
         /* can't write unknown spellbooks by description */
         pline("Unfortunately you don't have enough information to go on.");
         return 1;
@@ -190,8 +190,8 @@ found:
     pen->spe -= actualcost;
 
     /* can't write if we don't know it - unless we're lucky */
-    if (!(objects[new_obj->otyp].oc_name_known) &&
-        !(objects[new_obj->otyp].oc_uname) &&
+    if (!(objstate[new_obj->otyp].oc_name_known) &&
+        !(objstate[new_obj->otyp].oc_uname) &&
         (rnl(Role_if(PM_WIZARD) ? 3 : 15))) {
         pline("You %s to write that!", by_descr ? "fail" : "don't know how");
         /* scrolls disappear, spellbooks don't */
@@ -201,7 +201,7 @@ found:
             update_inventory(); /* pen charges */
         } else {
             if (by_descr) {
-                strcpy(namebuf, OBJ_DESCR(objects[new_obj->otyp]));
+                strcpy(namebuf, OBJ_DESCR(new_obj->otyp));
                 wipeout_text(namebuf, (6 + MAXULEV - u.ulevel) / 6, 0);
             } else
                 sprintf(namebuf, "%s was here!", plname);
@@ -219,7 +219,7 @@ found:
     if (new_obj->oclass == SPBOOK_CLASS) {
         /* acknowledge the change in the object's description... */
         pline("The spellbook warps strangely, then turns %s.",
-              OBJ_DESCR(objects[new_obj->otyp]));
+              OBJ_DESCR(new_obj->otyp));
     }
     new_obj->blessed = (curseval > 0);
     new_obj->cursed = (curseval < 0);
@@ -1047,7 +1047,7 @@ polyuse(struct obj *objhdr, int mat, int minwt)
         if (obj_resists(otmp, 0, 0))
             continue;   /* preserve unique objects */
 
-        if (((int)objects[otmp->otyp].oc_material == mat) ==
+        if (((int)objstate[otmp->otyp].oc_material == mat) ==
             (rn2(minwt + 1) != 0)) {
             /* appropriately add damage to bill */
             if (costly_spot(otmp->ox, otmp->oy)) {
@@ -1162,7 +1162,7 @@ do_osshock(struct obj *obj)
         /* some may metamorphosize */
         for (i = obj->quan; i; i--)
             if (!rn2(Luck + 45)) {
-                poly_zapped = objects[obj->otyp].oc_material;
+                poly_zapped = objstate[obj->otyp].oc_material;
                 break;
             }
     }
@@ -1345,8 +1345,8 @@ poly_obj(struct obj *obj, int id)
 
     case GEM_CLASS:
         if (otmp->quan > (long)rnd(4) &&
-            objects[obj->otyp].oc_material == MINERAL &&
-            objects[otmp->otyp].oc_material != MINERAL) {
+            objstate[obj->otyp].oc_material == MINERAL &&
+            objstate[otmp->otyp].oc_material != MINERAL) {
             otmp->otyp = ROCK;  /* transmutation backfired */
             otmp->quan /= 2L;   /* some material has been lost */
         }
@@ -1444,8 +1444,8 @@ hito_stone_to_flesh(struct obj *obj)
     xchar refresh_x = obj->ox;
     xchar refresh_y = obj->oy;
 
-    if (objects[obj->otyp].oc_material != MINERAL &&
-        objects[obj->otyp].oc_material != GEMSTONE)
+    if (objstate[obj->otyp].oc_material != MINERAL &&
+        objstate[obj->otyp].oc_material != GEMSTONE)
         return 0;
 
     /* add more if stone objects are added.. */
@@ -1826,7 +1826,7 @@ zapnodir(struct obj *obj)
         exercise(A_WIS, TRUE);
         break;
     }
-    if (known && !objects[obj->otyp].oc_name_known) {
+    if (known && !objstate[obj->otyp].oc_name_known) {
         makeknown(obj->otyp);
         more_experienced(0, 10);
     }
@@ -2485,7 +2485,7 @@ void
 weffects(struct obj *obj, schar dx, schar dy, schar dz)
 {
     int otyp = obj->otyp;
-    boolean disclose = FALSE, was_unkn = !objects[otyp].oc_name_known;
+    boolean disclose = FALSE, was_unkn = !objstate[otyp].oc_name_known;
 
     exercise(A_WIS, TRUE);
     if (u.usteed && (objects[otyp].oc_dir != NODIR) && !dx && !dy && (dz > 0) &&
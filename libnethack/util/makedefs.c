@@ -52,7 +52,7 @@ char *file_prefix = "";
 int main(int, char **);
 
 void do_objs(const char *);
-void do_data(const char *, const char *);
+void do_data(const char *, const char *, const char *);
 void do_dungeon(const char *, const char *);
 void do_date(const char *, int);
 void do_monstr(const char *);
@@ -94,7 +94,7 @@ static FILE *ifp, *ofp, *tfp;
 static const char *usage_info[] = {
     "usage: %s [MODE] [FILENAMES]\n",
     "       %s -o [OUT (onames.h)]\n",
-    "       %s -d [IN (data.base)] [OUT (data)]\n",
+    "       %s -d [IN (data.base)] [OUT (data)] [OUT (dataidx)]\n",
     "       %s -e [IN (dungeon.def)] [OUT (dungeon.pdf)]\n",
     "       %s -m [OUT (monstr.c)]\n",
     "       %s -v [OUT (date.h)] [OUT (options)]\n",
@@ -128,8 +128,6 @@ main(int argc, char *argv[])
     if (argc < 3)
         usage(argv[0], 0, 0);
 
-    init_objlist();
-
     /* construct the current version number */
     make_version();
 
@@ -143,9 +141,9 @@ main(int argc, char *argv[])
 
     case 'd':
     case 'D':
-        if (argc != 4)
-            usage(argv[0], argv[1][1], 4);
-        do_data(argv[2], argv[3]);
+        if (argc != 5)
+            usage(argv[0], argv[1][1], 5);
+        do_data(argv[2], argv[3], argv[4]);
         break;
 
     case 'e':
@@ -210,7 +208,6 @@ main(int argc, char *argv[])
         return 1;
     }
 
-    free(objects);
     return 0;
 }
 
@@ -435,15 +432,73 @@ d_filter(char *line)
     text-b/text-c               at fseek(0x01234567L + 456L)
     ...
     *
+    Alongside it we write an index, so that the game doesn't have to scan
+    and pmatch() every name to find an entry:
+    "do not edit"               comment line
+    3 640 1                     number of entries, of plain names and of
+                                names with wildcards or a leading '~'
+    2345,4                      absolute text offset and line count, per entry
+    ...
+    0 0 name-a                  entry and position in entry, per plain name
+    ...
+    1 1 ~ *-c                   entry, position, '~' or '-', and the pattern,
+    ...                         per special name, in file order
+    *
     */
 
+struct data_key {
+    char *name;
+    int entry, pos;
+};
+
+static void
+write_data_index(const char *indexfile, struct data_key *keys, int nkeys,
+                 long *offsets, int *counts, int nentries, long txt_offset)
+{
+    FILE *xfp;
+    int i, nplain = 0;
+
+    if (!(xfp = fopen(indexfile, WRTMODE))) {
+        perror(indexfile);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < nkeys; i++)
+        if (*keys[i].name != '~' && !strpbrk(keys[i].name, "*?"))
+            nplain++;
+
+    fprintf(xfp, "%s%d %d %d\n", Dont_Edit_Data, nentries, nplain,
+            nkeys - nplain);
+    for (i = 0; i < nentries; i++)
+        fprintf(xfp, "%ld,%d\n", txt_offset + offsets[i], counts[i]);
+    for (i = 0; i < nkeys; i++)
+        if (*keys[i].name != '~' && !strpbrk(keys[i].name, "*?"))
+            fprintf(xfp, "%d %d %s\n", keys[i].entry, keys[i].pos,
+                    keys[i].name);
+    for (i = 0; i < nkeys; i++)
+        if (*keys[i].name == '~' || strpbrk(keys[i].name, "*?"))
+            fprintf(xfp, "%d %d %c %s\n", keys[i].entry, keys[i].pos,
+                    *keys[i].name == '~' ? '~' : '-',
+                    keys[i].name + (*keys[i].name == '~'));
+
+    if (fclose(xfp) != 0) {
+        perror(indexfile);
+        unlink(indexfile);
+        exit(EXIT_FAILURE);
+    }
+}
+
 void
-do_data(const char *infile, const char *outfile)
+do_data(const char *infile, const char *outfile, const char *indexfile)
 {
     char tempfile[256];
     boolean ok;
     long txt_offset;
     int entry_cnt, line_cnt;
+    struct data_key *keys = NULL;
+    long *offsets = NULL;
+    int *counts = NULL;
+    int nkeys = 0, nentries = 0, entry_pos = 0;
 
     sprintf(tempfile, "%s.%s", outfile, "tmp");
 
@@ -474,23 +529,42 @@ do_data(const char *infile, const char *outfile)
             continue;
         if (*in_line > ' ') {   /* got an entry name */
             /* first finish previous entry */
-            if (line_cnt)
-                fprintf(ofp, "%d\n", line_cnt), line_cnt = 0;
+            if (line_cnt) {
+                fprintf(ofp, "%d\n", line_cnt);
+                counts[nentries++] = line_cnt;
+                line_cnt = entry_pos = 0;
+            }
             /* output the entry name */
             fputs(in_line, ofp);
             entry_cnt++;        /* update number of entries */
+
+            /* and remember it for the index */
+            keys = realloc(keys, entry_cnt * sizeof (struct data_key));
+            keys[nkeys].name = strdup(in_line);
+            keys[nkeys].name[strcspn(keys[nkeys].name, "\n")] = '\0';
+            keys[nkeys].entry = nentries;
+            keys[nkeys++].pos = entry_pos++;
         } else if (entry_cnt) { /* got some descriptive text */
             /* update previous entry with current text offset */
-            if (!line_cnt)
+            if (!line_cnt) {
                 fprintf(ofp, "%ld,", ftell(tfp));
+                offsets = realloc(offsets, (nentries + 1) * sizeof (long));
+                counts = realloc(counts, (nentries + 1) * sizeof (int));
+                offsets[nentries] = ftell(tfp);
+            }
             /* save the text line in the scratch file */
             fputs(in_line, tfp);
             line_cnt++; /* update line counter */
         }
     }
     /* output an end marker and then record the current position */
-    if (line_cnt)
+    if (line_cnt) {
         fprintf(ofp, "%d\n", line_cnt);
+        counts[nentries++] = line_cnt;
+    }
+    /* names at the end without text don't belong to any entry */
+    while (nkeys && keys[nkeys - 1].entry >= nentries)
+        free(keys[--nkeys].name);
     fprintf(ofp, ".\n%ld,%d\n", ftell(tfp), 0);
     txt_offset = ftell(ofp);
     fclose(ifp);        /* all done with original input file */
@@ -525,6 +599,14 @@ do_data(const char *infile, const char *outfile)
     /* all done */
     fclose(ofp);
 
+    write_data_index(indexfile, keys, nkeys, offsets, counts, nentries,
+                     txt_offset);
+    while (nkeys)
+        free(keys[--nkeys].name);
+    free(keys);
+    free(offsets);
+    free(counts);
+
     return;
 }
 
@@ -1212,8 +1294,7 @@ do_objs(const char *outfile)
     fprintf(ofp, "#ifndef ONAMES_H\n#define ONAMES_H\n\n");
 
     for (i = 0; !i || objects[i].oc_class != ILLOBJ_CLASS; i++) {
-        objects[i].oc_name_idx = objects[i].oc_descr_idx = i;   /* init */
-        if (!(objnam = tmpdup(OBJ_NAME(objects[i]))))
+        if (!(objnam = tmpdup(OBJ_NAME(i))))
             continue;
 
         /* make sure probabilities add up to 1000 */
@@ -1258,7 +1339,7 @@ do_objs(const char *outfile)
         case AMULET_CLASS:
             /* avoid trouble with stupid C preprocessors */
             fprintf(ofp, "#define\t");
-            if (objects[i].oc_material == PLASTIC) {
+            if (const_objstate[i].oc_material == PLASTIC) {
                 fprintf(ofp, "FAKE_AMULET_OF_YENDOR\t%d\n", i);
                 prefix = -1;
                 break;
@@ -1271,7 +1352,7 @@ do_objs(const char *outfile)
             fprintf(ofp, "%s\t%d\n", limit(objnam, prefix), i);
         prefix = 0;
 
-        sum += objects[i].oc_prob;
+        sum += const_objstate[i].oc_prob;
     }
 
     /* check last set of probabilities */
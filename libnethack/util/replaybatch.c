@@ -0,0 +1,523 @@
+/* vim:set cin ft=c sw=4 sts=4 ts=8 et ai cino=Ls\:0t0(0 : -*- mode:c;fill-column:80;tab-width:8;c-basic-offset:4;indent-tabs-mode:nil;c-file-style:"k&r" -*-*/
+/* NetHack may be freely redistributed.  See license for details. */
+
+/* replaybatch: replay every finished game in a directory of logs (with -s,
+ * saved games as well).
+ *
+ * Each game is replayed to the end with null window procs in a process of its
+ * own, so that a panic in one replay can't affect the others.  Every recorded
+ * diff is compared with a save of the replayed game (nh_view_replay_verify),
+ * which makes this both a regression test for replay compatibility and a
+ * benchmark for save.c, memfile.c and logreplay.c.  The exit status is
+ * nonzero if any game desynced or could not be replayed. */
+
+#define _XOPEN_SOURCE 700
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "nethack.h"
+
+enum replay_result {
+    RR_OK,
+    RR_SKIPPED,         /* not a finished game */
+    RR_FAILED,          /* couldn't be opened or started */
+    RR_CRASHED          /* the replay process died */
+};
+
+struct game_result {
+    enum replay_result result;
+    int actions, max_actions;
+    int moves;
+    int desyncs;
+    long maxrss;        /* kilobytes */
+    unsigned long long nsec;
+};
+
+struct worker {
+    pid_t pid;
+    int pipefd;
+    int game;
+};
+
+static nh_bool replay_saved;
+
+
+static void
+null_pause(enum nh_pause_reason reason)
+{
+}
+
+static void
+null_display_buffer(const char *buf, nh_bool trymove)
+{
+}
+
+static void
+null_update_status(struct nh_player_info *pi)
+{
+}
+
+static void
+null_print_message(int turn, const char *msg)
+{
+}
+
+static int
+null_display_menu(struct nh_menuitem *items, int icount, const char *title,
+                  int how, int placement_hint, int *results)
+{
+    return 0;
+}
+
+static int
+null_display_objects(struct nh_objitem *items, int icount, const char *title,
+                     int how, int placement_hint, struct nh_objresult *pick_list)
+{
+    return 0;
+}
+
+static nh_bool
+null_list_items(struct nh_objitem *items, int icount, nh_bool invent)
+{
+    return TRUE;
+}
+
+static void
+null_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
+{
+}
+
+static void
+null_raw_print(const char *str)
+{
+    /* the only output a replay produces on its own is an error report */
+    if (*str)
+        fprintf(stderr, "  %s\n", str);
+}
+
+static char
+null_query_key(const char *query, int *count)
+{
+    if (count)
+        *count = -1;
+    return '\033';
+}
+
+static int
+null_getpos(int *x, int *y, nh_bool force, const char *goal)
+{
+    return force ? 0 : -1;
+}
+
+static enum nh_direction
+null_getdir(const char *query, nh_bool restricted)
+{
+    return DIR_NONE;
+}
+
+static char
+null_yn_function(const char *query, const char *rset, char defchoice)
+{
+    return defchoice ? defchoice : '\033';
+}
+
+static void
+null_getlin(const char *query, char *buf)
+{
+    strcpy(buf, "\033");
+}
+
+static void
+null_delay(void)
+{
+}
+
+static void
+null_level_changed(int displaymode)
+{
+}
+
+static void
+null_outrip(struct nh_menuitem *items, int icount, nh_bool tombstone,
+            const char *name, int gold, const char *killbuf, int end_how,
+            int year)
+{
+}
+
+static struct nh_window_procs null_windowprocs = {
+    null_pause,
+    null_display_buffer,
+    null_update_status,
+    null_print_message,
+    null_display_menu,
+    null_display_objects,
+    null_list_items,
+    null_update_screen,
+    null_raw_print,
+    null_query_key,
+    null_getpos,
+    null_getdir,
+    null_yn_function,
+    null_getlin,
+    null_delay,
+    null_level_changed,
+    null_outrip,
+    null_print_message,
+};
+
+
+static unsigned long long
+wallclock(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+static int
+compare_names(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+
+/* returns a sorted list of the .nhgame files in dirname */
+static char **
+list_logs(const char *dirname, int *count)
+{
+    DIR *dirp;
+    struct dirent *dp;
+    char **files = NULL;
+    int namelen, size = 0;
+
+    *count = 0;
+    dirp = opendir(dirname);
+    if (!dirp)
+        return NULL;
+
+    while ((dp = readdir(dirp)) != NULL) {
+        namelen = strlen(dp->d_name);
+        if (namelen <= 7 || strcmp(&dp->d_name[namelen - 7], ".nhgame"))
+            continue;
+
+        if (*count >= size) {
+            size = size ? size * 2 : 64;
+            files = realloc(files, size * sizeof (char *));
+        }
+        files[*count] = malloc(strlen(dirname) + namelen + 2);
+        sprintf(files[*count], "%s/%s", dirname, dp->d_name);
+        (*count)++;
+    }
+    closedir(dirp);
+
+    if (*count)
+        qsort(files, *count, sizeof (char *), compare_names);
+    return files;
+}
+
+
+/* runs in the worker process */
+static void
+replay_game(const char *filename, struct game_result *res)
+{
+    struct nh_replay_info info;
+    struct nh_game_info gi;
+    struct rusage usage;
+    unsigned long long start;
+    enum nh_log_status status;
+    int fd;
+
+    memset(res, 0, sizeof (struct game_result));
+    res->result = RR_FAILED;
+
+    fd = open(filename, O_RDWR);
+    if (fd == -1)
+        return;
+
+    status = nh_get_savegame_status(fd, &gi);
+    if (status != LS_DONE && !(replay_saved && status == LS_SAVED)) {
+        res->result = RR_SKIPPED;
+        close(fd);
+        return;
+    }
+
+    nh_view_replay_verify(TRUE);
+    start = wallclock();
+    if (!nh_view_replay_start(fd, &null_windowprocs, &info)) {
+        close(fd);
+        return;
+    }
+
+    /* max_moves is the turn the game ended or was saved on; the actions on
+       that turn are stepped through one by one */
+    nh_view_replay_step(&info, REPLAY_GOTO, info.max_moves);
+    while (info.actions < info.max_actions &&
+           nh_view_replay_step(&info, REPLAY_FORWARD, 1))
+        ;
+    res->nsec = wallclock() - start;
+
+    res->result = RR_OK;
+    res->actions = info.actions;
+    res->max_actions = info.max_actions;
+    res->moves = info.moves;
+    res->desyncs = info.desyncs;
+
+    nh_view_replay_finish();
+    close(fd);
+
+    getrusage(RUSAGE_SELF, &usage);
+    res->maxrss = usage.ru_maxrss;
+}
+
+
+static nh_bool
+start_worker(struct worker *w, int game, const char *filename)
+{
+    struct game_result res;
+    int fds[2];
+
+    if (pipe(fds) == -1)
+        return FALSE;
+
+    fflush(NULL);
+    w->pid = fork();
+    if (w->pid == -1) {
+        w->pid = 0;
+        close(fds[0]);
+        close(fds[1]);
+        return FALSE;
+    }
+
+    if (w->pid == 0) {
+        close(fds[0]);
+        replay_game(filename, &res);
+        /* a game_result is far smaller than PIPE_BUF, so this can't block */
+        if (write(fds[1], &res, sizeof (res)) != sizeof (res))
+            _exit(1);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    w->pipefd = fds[0];
+    w->game = game;
+    return TRUE;
+}
+
+
+/* collect the result of a worker that has exited */
+static void
+finish_worker(struct worker *w, struct game_result *results)
+{
+    struct game_result *res = &results[w->game];
+
+    if (read(w->pipefd, res, sizeof (*res)) != sizeof (*res)) {
+        memset(res, 0, sizeof (*res));
+        res->result = RR_CRASHED;
+    }
+    close(w->pipefd);
+    w->pid = 0;
+}
+
+
+static void
+print_result(const char *filename, const struct game_result *res)
+{
+    const char *basename = strrchr(filename, '/');
+
+    basename = basename ? basename + 1 : filename;
+    switch (res->result) {
+    case RR_SKIPPED:
+        printf("%-40s skipped (not a finished game)\n", basename);
+        break;
+    case RR_FAILED:
+        printf("%-40s FAILED to start\n", basename);
+        break;
+    case RR_CRASHED:
+        printf("%-40s CRASHED\n", basename);
+        break;
+    case RR_OK:
+        printf("%-40s %7d/%-7d actions %7d moves %8.0f act/s %7ld kB"
+               " %s%d desyncs\n", basename, res->actions, res->max_actions,
+               res->moves, res->nsec ?
+               res->actions * 1.0e9 / res->nsec : 0.0, res->maxrss,
+               res->desyncs ? "** " : "", res->desyncs);
+        break;
+    }
+}
+
+
+static int
+remove_entry(const char *path, const struct stat *sb, int flag,
+             struct FTW *ftwbuf)
+{
+    remove(path);
+    return 0;
+}
+
+
+static void
+print_usage(const char *progname)
+{
+    printf("Usage: %s [OPTIONS] <log directory>\n", progname);
+    printf("  -d <directory>   Directory containing nhdat."
+           " Default: \"" NETHACKDIR "\"\n");
+    printf("  -j <number>      Replay this many games in parallel."
+           " Default: 1\n");
+    printf("  -m <kilobytes>   Memory for replay checkpoints; the rest"
+           " goes to a\n"
+           "                   temporary file. 0 means no limit."
+           " Default: 65536\n");
+    printf("  -s               Replay saved games too, not only finished"
+           " ones.\n");
+    printf("  -h               Show this message.\n");
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    const char *datadir = NETHACKDIR;
+    char workdir[] = "/tmp/replaybatch.XXXXXX", datapath[4096];
+    char *paths[PREFIX_COUNT], **files;
+    struct game_result *results;
+    struct worker *workers;
+    unsigned long long start, elapsed;
+    long total_actions = 0, peak_rss = 0;
+    int opt, i, j, nfiles, next, running, jobs = 1;
+    long cp_kbytes = 64 * 1024;
+    pid_t pid;
+    int replayed = 0, skipped = 0, failed = 0, desynced = 0, desyncs = 0;
+
+    while ((opt = getopt(argc, argv, "d:hj:m:s")) != -1) {
+        switch (opt) {
+        case 'd':
+            datadir = optarg;
+            break;
+        case 'j':
+            jobs = atoi(optarg);
+            break;
+        case 'm':
+            cp_kbytes = atol(optarg);
+            break;
+        case 's':
+            replay_saved = TRUE;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt != 'h';
+        }
+    }
+    if (optind != argc - 1 || jobs < 1 || cp_kbytes < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    files = list_logs(argv[optind], &nfiles);
+    if (!files) {
+        fprintf(stderr, "Error: no game logs found in %s\n", argv[optind]);
+        return 1;
+    }
+
+    /* replays shouldn't write anything, but keep any panic logs etc. out of
+       the data directory */
+    if (!mkdtemp(workdir)) {
+        fprintf(stderr, "Error: could not create a work directory: %s\n",
+                strerror(errno));
+        return 1;
+    }
+    snprintf(datapath, sizeof (datapath), "%s/", datadir);
+    for (i = 0; i < PREFIX_COUNT; i++) {
+        paths[i] = malloc(strlen(workdir) + 2);
+        sprintf(paths[i], "%s/", workdir);
+    }
+    free(paths[DATAPREFIX]);
+    paths[DATAPREFIX] = datapath;
+
+    /* the library is initialized once; each worker inherits it */
+    nh_lib_init(&null_windowprocs, paths);
+    nh_view_replay_checkpoint_memory(cp_kbytes * 1024ULL);
+
+    results = calloc(nfiles, sizeof (struct game_result));
+    workers = calloc(jobs, sizeof (struct worker));
+    start = wallclock();
+    next = running = 0;
+    while (next < nfiles || running) {
+        for (j = 0; j < jobs && next < nfiles; j++) {
+            if (workers[j].pid)
+                continue;
+            if (start_worker(&workers[j], next, files[next]))
+                running++;
+            else
+                results[next].result = RR_FAILED;
+            next++;
+        }
+        if (!running)
+            continue;
+
+        pid = waitpid(-1, NULL, 0);
+        if (pid == -1)
+            break;
+        for (j = 0; j < jobs; j++)
+            if (workers[j].pid == pid) {
+                finish_worker(&workers[j], results);
+                running--;
+            }
+    }
+    elapsed = wallclock() - start;
+
+    nh_lib_exit();
+    nftw(workdir, remove_entry, 8, FTW_DEPTH | FTW_PHYS);
+
+    /* results are printed in file order, whatever order they finished in */
+    for (i = 0; i < nfiles; i++) {
+        print_result(files[i], &results[i]);
+        switch (results[i].result) {
+        case RR_OK:
+            replayed++;
+            total_actions += results[i].actions;
+            desyncs += results[i].desyncs;
+            if (results[i].desyncs)
+                desynced++;
+            if (results[i].maxrss > peak_rss)
+                peak_rss = results[i].maxrss;
+            break;
+        case RR_SKIPPED:
+            skipped++;
+            break;
+        default:
+            failed++;
+            break;
+        }
+    }
+
+    printf("\n%d games replayed, %d skipped, %d failed; "
+           "%d desyncs in %d games\n", replayed, skipped, failed, desyncs,
+           desynced);
+    printf("%ld actions in %.2f s (%.0f actions/s with %d jobs), "
+           "peak RSS %ld kB\n", total_actions, elapsed / 1.0e9,
+           elapsed ? total_actions * 1.0e9 / elapsed : 0.0, jobs, peak_rss);
+
+    for (i = 0; i < nfiles; i++)
+        free(files[i]);
+    free(files);
+    for (i = 0; i < PREFIX_COUNT; i++)
+        if (i != DATAPREFIX)
+            free(paths[i]);
+    free(results);
+    free(workers);
+
+    return failed || desyncs;
+}
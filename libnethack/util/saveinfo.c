@@ -243,6 +243,13 @@ parse_timezone(char *token, long tcount)
 }
 
 
+static void
+parse_continued(void)
+{
+    printf("continued ");
+}
+
+
 static void
 parse_result(char *token)
 {
@@ -369,6 +376,9 @@ main(int argc, char *argv[])
         case 'o':
             printf("objects ");
             break;
+        case '*':
+            parse_continued();
+            break;
         case '<':
             parse_result(tokens[tnum]);
             printf("\n");
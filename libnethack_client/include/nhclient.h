@@ -28,9 +28,16 @@
 #  define close closesocket
 # endif
 # include <jansson.h>
+# include <zlib.h>
 
 # define DEFAULT_PORT 53421     /* matches the definition in nhserver.h */
 
+/* optional protocol extensions, as announced by the server after auth */
+# define FEATURE_GAME_COMMAND_BATCH     0x01
+# define FEATURE_UPDATE_SCREEN_PACKED   0x02
+# define FEATURE_DEFLATE                0x04
+# define FEATURE_UPDATE_INVENTORY       0x08
+
 extern struct nh_window_procs windowprocs, alt_windowprocs;
 extern int current_game;
 extern jmp_buf ex_jmp_buf;
@@ -38,6 +45,7 @@ extern int ex_jmp_buf_valid;
 extern int conn_err;
 extern int error_retry_ok;
 extern char saved_password[];
+extern unsigned int server_features;
 
 /* clientapi.c */
 extern void free_option_lists(void);
@@ -200,19 +200,10 @@ nhnet_start_game(const char *name, int role, int race, int gend, int align,
 }
 
 
-int
-nhnet_command(const char * volatile cmd, int rep, struct nh_cmd_arg *arg)
+static json_t *
+pack_game_command(const char *cmd, int rep, const struct nh_cmd_arg *arg)
 {
-    int ret;
-    json_t *jmsg, *jarg;
-
-    if (!nhnet_active())
-        return nh_command(cmd, rep, arg);
-
-    if (!api_entry())
-        return ERR_NETWORK_ERROR;
-
-    xmalloc_cleanup();
+    json_t *jarg;
 
     switch (arg->argtype) {
     case CMD_ARG_DIR:
@@ -237,10 +228,26 @@ nhnet_command(const char * volatile cmd, int rep, struct nh_cmd_arg *arg)
         break;
     }
 
-    jmsg =
-        json_pack("{ss,so,si}", "command", cmd ? cmd : "", "arg", jarg, "count",
-                  rep);
-    jmsg = send_receive_msg("game_command", jmsg);
+    return json_pack("{ss,so,si}", "command", cmd ? cmd : "", "arg", jarg,
+                     "count", rep);
+}
+
+
+int
+nhnet_command(const char * volatile cmd, int rep, struct nh_cmd_arg *arg)
+{
+    int ret;
+    json_t *jmsg;
+
+    if (!nhnet_active())
+        return nh_command(cmd, rep, arg);
+
+    if (!api_entry())
+        return ERR_NETWORK_ERROR;
+
+    xmalloc_cleanup();
+
+    jmsg = send_receive_msg("game_command", pack_game_command(cmd, rep, arg));
     if (json_unpack(jmsg, "{si!}", "return", &ret) == -1) {
         print_error("Incorrect return object in nhnet_command");
         ret = 0;
@@ -252,6 +259,63 @@ nhnet_command(const char * volatile cmd, int rep, struct nh_cmd_arg *arg)
 }
 
 
+/* Run several commands with a single round trip to the server.  The commands
+ * are run in order for as long as each one returns READY_FOR_INPUT and doesn't
+ * need to ask the player anything; the rest are dropped.  *ndone is set to the
+ * number of commands that were run and the status of the last one is
+ * returned, just as nhnet_command would have returned it.
+ * Servers without support for batches and local games get the commands one at
+ * a time, with the same rule for stopping (except that a local game can't
+ * tell that it prompted). */
+int
+nhnet_command_batch(const struct nhnet_queued_command *cmds, int ncmds,
+                    int *ndone)
+{
+    int i, ret, done;
+    json_t *jmsg, *jcmds;
+    struct nh_cmd_arg arg;
+
+    *ndone = 0;
+    if (ncmds <= 0)
+        return READY_FOR_INPUT;
+
+    if (!nhnet_active() || !(server_features & FEATURE_GAME_COMMAND_BATCH)) {
+        ret = READY_FOR_INPUT;
+        for (i = 0; i < ncmds && ret == READY_FOR_INPUT; i++) {
+            arg = cmds[i].arg;
+            ret = nhnet_command(cmds[i].cmd, cmds[i].rep, &arg);
+            *ndone = i + 1;
+        }
+        return ret;
+    }
+
+    if (!api_entry())
+        return ERR_NETWORK_ERROR;
+
+    xmalloc_cleanup();
+
+    jcmds = json_array();
+    for (i = 0; i < ncmds; i++)
+        json_array_append_new(jcmds, pack_game_command(cmds[i].cmd,
+                                                       cmds[i].rep,
+                                                       &cmds[i].arg));
+
+    jmsg = send_receive_msg("game_command_batch",
+                            json_pack("{so}", "commands", jcmds));
+    if (json_unpack(jmsg, "{si,si!}", "return", &ret, "done", &done) == -1 ||
+        done < 1 || done > ncmds) {
+        print_error("Incorrect return object in nhnet_command_batch");
+        ret = 0;
+        done = 0;
+    }
+    *ndone = done;
+
+    json_decref(jmsg);
+    api_exit();
+    return ret;
+}
+
+
 nh_bool
 nhnet_view_replay_start(int fd, struct nh_window_procs * rwinprocs,
                         struct nh_replay_info * info)
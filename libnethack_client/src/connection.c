@@ -8,6 +8,7 @@
 #include "nhclient.h"
 
 struct nhnet_server_version nhnet_server_ver;
+unsigned int server_features;
 
 static int sockfd = -1;
 static int connection_id;
@@ -97,6 +98,116 @@ send_json_msg(json_t * jmsg)
 }
 
 
+/* Data received from the server that hasn't been returned yet. The buffer is
+ * kept for the whole connection so that receiving a response usually costs
+ * neither an allocation nor more than one recv().
+ * Responses are framed by tracking the nesting depth of the JSON text as it
+ * arrives, so each byte is looked at once and the parser only runs when a
+ * complete object is in the buffer. */
+static char *rbuf;
+static int rbufsize, rbuflen;
+static int scanpos, scandepth, scan_in_string, scan_escaped;
+
+/* If the server compresses its output, the received data goes through zbuf
+ * and is inflated into rbuf.  The server flushes the stream after every
+ * message, so a complete message can always be inflated completely. */
+static z_stream zin;
+static int inflating, zin_initialized;
+static unsigned char zbuf[16384];
+
+static void
+reset_receive_buffer(void)
+{
+    rbuflen = scanpos = scandepth = 0;
+    scan_in_string = scan_escaped = FALSE;
+    zin.avail_in = 0;
+}
+
+
+static void
+free_receive_buffer(void)
+{
+    reset_receive_buffer();
+    free(rbuf);
+    rbuf = NULL;
+    rbufsize = 0;
+    if (zin_initialized)
+        inflateEnd(&zin);
+    zin_initialized = inflating = FALSE;
+}
+
+
+/* everything the server sends after the response to set_features is
+   compressed */
+static void
+start_decompression(void)
+{
+    if (!zin_initialized)
+        zin_initialized = inflateInit(&zin) == Z_OK;
+    else
+        inflateReset(&zin);
+    zin.avail_in = 0;
+    inflating = zin_initialized;
+}
+
+
+/* inflate as much of the data in zbuf as fits into rbuf */
+static int
+inflate_received(void)
+{
+    int ret;
+
+    zin.next_out = (unsigned char *)&rbuf[rbuflen];
+    zin.avail_out = rbufsize - rbuflen;
+    ret = inflate(&zin, Z_SYNC_FLUSH);
+    rbuflen = rbufsize - zin.avail_out;
+    return ret == Z_OK || ret == Z_BUF_ERROR;
+}
+
+
+/* look at the newly received data; returns the length of the first complete
+ * JSON value in the buffer, or 0 if it isn't complete yet */
+static int
+scan_json_frame(void)
+{
+    char c;
+
+    for (; scanpos < rbuflen; scanpos++) {
+        c = rbuf[scanpos];
+        if (scan_in_string) {
+            if (scan_escaped)
+                scan_escaped = FALSE;
+            else if (c == '\\')
+                scan_escaped = TRUE;
+            else if (c == '"')
+                scan_in_string = FALSE;
+        } else if (c == '"')
+            scan_in_string = TRUE;
+        else if (c == '{' || c == '[')
+            scandepth++;
+        else if ((c == '}' || c == ']') && --scandepth <= 0)
+            return ++scanpos;
+    }
+    return 0;
+}
+
+
+/* the responses are read with blocking recv() calls; this timeout ensures
+ * that the program doesn't hang indefinitely if the connection has failed */
+static void
+set_receive_timeout(int fd)
+{
+#ifdef UNIX
+    /* 10s * 3 retries results in a long wait on failed connections... */
+    struct timeval tv = { 10, 0 };
+#else
+    DWORD tv = 10 * 1000;
+#endif
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const void *)&tv, sizeof (tv));
+}
+
+
 /* receive one JSON object from the server.
  * Returns: - NULL after a network error OR
  *          - an empty JSON object if there is a parsing error OR
@@ -104,78 +215,76 @@ send_json_msg(json_t * jmsg)
 static json_t *
 receive_json_msg(void)
 {
-    char *rbuf, *bp;
-    int datalen, ret, rbufsize;
+    int framelen, ret;
     json_t *recv_msg;
     json_error_t err;
-    fd_set rfds;
-    struct timeval tv;
-
-    FD_ZERO(&rfds);
-    FD_SET(sockfd, &rfds);
 
-    rbufsize = 1024 * 1024;     /* initial size: 1MB */
-    rbuf = malloc(rbufsize);
-    memset(rbuf, 0, rbufsize);
-    recv_msg = NULL;
-    datalen = 0;
-    while (!recv_msg) {
-        /* select before reading so that we get a timeout. Otherwise the
-           program might hang indefinitely in read if the connection has failed 
-         */
-        tv.tv_sec = 10; /* 10s * 3 retries results in a long wait on failed
-                           connections... */
-        tv.tv_usec = 0;
-        ret = select(sockfd + 1, &rfds, NULL, NULL, &tv);
-        if (ret <= 0) {
-            /* we aren't expecting any signals, so it seems ok to abort even if
-               ret == -1 && errno == EINTR */
-            free(rbuf);
-            return NULL;
-        }
-
-        /* leave the last byte in the buffer free for the '\0' */
-        ret = recv(sockfd, &rbuf[datalen], rbufsize - datalen - 1, 0);
-        if (ret == -1 && errno == EINTR)
-            continue;
-        else if (ret <= 0) {
-            free(rbuf);
-            return NULL;
-        }
-        datalen += ret;
-
-        rbuf[datalen] = '\0';   /* terminate the string */
-        bp = &rbuf[datalen - 1];
-        while (isspace(*bp))
-            bp--;
-
-        recv_msg = NULL;
-        if (*bp == '}') {       /* possibly the end of the json object */
-            recv_msg = json_loads(rbuf, JSON_REJECT_DUPLICATES, &err);
-            if (!recv_msg && err.position < datalen) {
-                print_error("Broken response received from server.");
-                free(rbuf);
-                return json_object();
-            }
-        }
+    if (!rbuf) {
+        rbufsize = 64 * 1024;
+        rbuf = malloc(rbufsize);
+    }
 
+    /* a previous recv() may already have fetched (part of) this response */
+    while (!(framelen = scan_json_frame())) {
         /* allow the receive buffer to grow to 16MB. Growing larger than 1MB is
            extremely unlikely (I can't imagine how it would happen); 16MB or
            more is clearly an error. */
-        if (!recv_msg && datalen >= rbufsize - 1) {
-            if (datalen < 16 * 1024 * 1024) {
+        if (rbuflen == rbufsize) {
+            if (rbufsize < 16 * 1024 * 1024) {
                 rbufsize *= 2;
                 rbuf = realloc(rbuf, rbufsize);
             } else {
                 print_error("Too much incoming data. Server error?");
-                free(rbuf);
+                reset_receive_buffer();
                 return json_object();
             }
         }
+
+        /* compressed data left over because rbuf was full */
+        if (inflating && zin.avail_in > 0) {
+            if (!inflate_received())
+                goto bad_data;
+            continue;
+        }
+
+        if (inflating)
+            ret = recv(sockfd, zbuf, sizeof (zbuf), 0);
+        else
+            ret = recv(sockfd, &rbuf[rbuflen], rbufsize - rbuflen, 0);
+        if (ret == -1 && errno == EINTR)
+            continue;
+        else if (ret <= 0) {
+            /* timeout, error or EOF: whatever was received is useless */
+            reset_receive_buffer();
+            return NULL;
+        }
+
+        if (inflating) {
+            zin.next_in = zbuf;
+            zin.avail_in = ret;
+            if (!inflate_received())
+                goto bad_data;
+        } else
+            rbuflen += ret;
     }
 
-    free(rbuf);
+    recv_msg = json_loadb(rbuf, framelen, JSON_REJECT_DUPLICATES, &err);
+
+    /* keep anything received after the end of this response */
+    rbuflen -= framelen;
+    if (rbuflen)
+        memmove(rbuf, &rbuf[framelen], rbuflen);
+    scanpos = scandepth = 0;
+    scan_in_string = scan_escaped = FALSE;
+
+    if (!recv_msg)
+        goto bad_data;
     return recv_msg;
+
+bad_data:
+    print_error("Broken response received from server.");
+    reset_receive_buffer();
+    return json_object();
 }
 
 
@@ -366,8 +475,10 @@ do_connect(const char *host, int port, const char *user, const char *pass,
            const char *email, int reg_user, int connid)
 {
     int fd = -1, authresult, copylen;
+    size_t i;
     char ipv6_error[120], ipv4_error[120], errmsg[256];
-    json_t *jmsg, *jarr;
+    const char *feature;
+    json_t *jmsg, *jarr, *jfeatures;
 
 #ifdef UNIX
     /* try to connect to a local unix socket */
@@ -418,6 +529,9 @@ do_connect(const char *host, int port, const char *user, const char *pass,
 
     in_connect_disconnect = TRUE;
     sockfd = fd;
+    set_receive_timeout(fd);
+    reset_receive_buffer();
+    inflating = FALSE;
     jmsg = json_pack("{ss,ss}", "username", user, "password", pass);
     if (reg_user) {
         if (email)
@@ -446,8 +560,51 @@ do_connect(const char *host, int port, const char *user, const char *pass,
         nhnet_server_ver.patchlevel =
             json_integer_value(json_array_get(jarr, 2));
     }
+    /* so is "features"; older servers support none of the extensions */
+    server_features = 0;
+    if (json_unpack(jmsg, "{so*}", "features", &jarr) != -1 &&
+        json_is_array(jarr)) {
+        for (i = 0; i < json_array_size(jarr); i++) {
+            feature = json_string_value(json_array_get(jarr, i));
+            if (feature && !strcmp(feature, "game_command_batch"))
+                server_features |= FEATURE_GAME_COMMAND_BATCH;
+            else if (feature && !strcmp(feature, "update_screen_packed"))
+                server_features |= FEATURE_UPDATE_SCREEN_PACKED;
+            else if (feature && !strcmp(feature, "deflate"))
+                server_features |= FEATURE_DEFLATE;
+            else if (feature && !strcmp(feature, "update_inventory"))
+                server_features |= FEATURE_UPDATE_INVENTORY;
+        }
+    }
     json_decref(jmsg);
 
+    /* extensions that change what the server sends must be asked for */
+    if ((server_features & (FEATURE_UPDATE_SCREEN_PACKED | FEATURE_DEFLATE |
+                            FEATURE_UPDATE_INVENTORY)) &&
+        (authresult == AUTH_SUCCESS_NEW ||
+         authresult == AUTH_SUCCESS_RECONNECT)) {
+        jfeatures = json_array();
+        if (server_features & FEATURE_UPDATE_SCREEN_PACKED)
+            json_array_append_new(jfeatures,
+                                  json_string("update_screen_packed"));
+        if (server_features & FEATURE_DEFLATE)
+            json_array_append_new(jfeatures, json_string("deflate"));
+        if (server_features & FEATURE_UPDATE_INVENTORY)
+            json_array_append_new(jfeatures,
+                                  json_string("update_inventory"));
+
+        in_connect_disconnect = TRUE;
+        jmsg = send_receive_msg("set_features",
+                                json_pack("{so}", "features", jfeatures));
+        in_connect_disconnect = FALSE;
+        if (!jmsg)
+            return NO_CONNECTION;
+        json_decref(jmsg);
+
+        if (server_features & FEATURE_DEFLATE)
+            start_decompression();
+    }
+
     if (host != saved_hostname)
         strncpy(saved_hostname, host, sizeof (saved_hostname));
     if (user != saved_username)
@@ -491,9 +648,11 @@ nhnet_disconnect(void)
     current_game = 0;
     conn_err = FALSE;
     net_active = FALSE;
+    free_receive_buffer();
     xmalloc_cleanup();
     free_option_lists();
     memset(&nhnet_server_ver, 0, sizeof (nhnet_server_ver));
+    server_features = 0;
 }
 
 
@@ -19,12 +19,14 @@ static json_t *cmd_update_status(json_t * params, int display_only);
 static json_t *cmd_print_message(json_t * params, int display_only);
 static json_t *cmd_print_message_nonblocking(json_t * params, int display_only);
 static json_t *cmd_update_screen(json_t * params, int display_only);
+static json_t *cmd_update_screen_packed(json_t * params, int display_only);
 static json_t *cmd_delay_output(json_t * params, int display_only);
 static json_t *cmd_level_changed(json_t * params, int display_only);
 static json_t *cmd_outrip(json_t * params, int display_only);
 static json_t *cmd_display_menu(json_t * params, int display_only);
 static json_t *cmd_display_objects(json_t * params, int display_only);
 static json_t *cmd_list_items(json_t * params, int display_only);
+static json_t *cmd_update_inventory(json_t * params, int display_only);
 static json_t *cmd_query_key(json_t * params, int display_only);
 static json_t *cmd_getpos(json_t * params, int display_only);
 static json_t *cmd_getdir(json_t * params, int display_only);
@@ -43,12 +45,14 @@ struct netcmd netcmd_list[] = {
     {"update_status", cmd_update_status},
     {"print_message", cmd_print_message},
     {"update_screen", cmd_update_screen},
+    {"update_screen_packed", cmd_update_screen_packed},
     {"delay_output", cmd_delay_output},
     {"level_changed", cmd_level_changed},
     {"outrip", cmd_outrip},
     {"display_menu", cmd_display_menu},
     {"display_objects", cmd_display_objects},
     {"list_items", cmd_list_items},
+    {"update_inventory", cmd_update_inventory},
     {"query_key", cmd_query_key},
     {"getpos", cmd_getpos},
     {"getdir", cmd_getdir},
@@ -62,6 +66,19 @@ struct netcmd netcmd_list[] = {
 
 static struct nh_window_procs cur_wndprocs;
 
+/* the inventory as last shown, which update_inventory messages modify */
+static struct nh_objitem *cur_invent;
+static int cur_invent_icount;
+
+/* the map as last shown, which update_screen messages modify */
+static struct nh_dbuf_entry cur_dbuf[ROWNO][COLNO];
+
+/* the session's palette for update_screen_packed; see the server's
+   winprocs.c for the format */
+#define PACKED_RUN_MULT 65536
+static struct nh_dbuf_entry *screen_palette;
+static int screen_palette_size, screen_palette_alloc;
+
 /*---------------------------------------------------------------------------*/
 
 static const char *
@@ -299,7 +316,7 @@ cmd_print_message_nonblocking(json_t * params, int display_only)
 static json_t *
 cmd_update_screen(json_t * params, int display_only)
 {
-    static struct nh_dbuf_entry dbuf[ROWNO][COLNO];
+    struct nh_dbuf_entry (*dbuf)[COLNO] = cur_dbuf;
     int ux, uy;
     int x, y, effect, bg, trap, obj, obj_mn, mon, monflags, branding, invis,
         visible;
@@ -376,6 +393,75 @@ cmd_update_screen(json_t * params, int display_only)
 }
 
 
+
+static json_t *
+cmd_update_screen_packed(json_t * params, int display_only)
+{
+    int ux, uy, base, i, n, end, run, sym;
+    int effect, bg, trap, obj, obj_mn, mon, monflags, branding, flags;
+    struct nh_dbuf_entry *dbe;
+    json_t *jpalette, *jruns;
+
+    if (json_unpack(params, "{si,si,si,so,so!}", "ux", &ux, "uy", &uy, "base",
+                    &base, "palette", &jpalette, "runs", &jruns) == -1 ||
+        !json_is_array(jpalette) || !json_is_array(jruns)) {
+        print_error("Incorrect parameters in cmd_update_screen_packed");
+        return NULL;
+    }
+
+    /* base 0 starts a new palette; otherwise the new entries must follow on
+       from the ones we have */
+    if (base != 0 && base != screen_palette_size) {
+        print_error("Palette mismatch in cmd_update_screen_packed");
+        return NULL;
+    }
+    screen_palette_size = base;
+    n = json_array_size(jpalette);
+    if (screen_palette_size + n > screen_palette_alloc) {
+        screen_palette_alloc = (screen_palette_size + n) * 2;
+        screen_palette = realloc(screen_palette, screen_palette_alloc *
+                                 sizeof (struct nh_dbuf_entry));
+    }
+    for (i = 0; i < n; i++) {
+        dbe = &screen_palette[screen_palette_size++];
+        memset(dbe, 0, sizeof (struct nh_dbuf_entry));
+        if (json_unpack(json_array_get(jpalette, i), "[i,i,i,i,i,i,i,i,i!]",
+                        &effect, &bg, &trap, &obj, &obj_mn, &mon, &monflags,
+                        &branding, &flags) == -1) {
+            print_error("Strange palette entry in cmd_update_screen_packed");
+            continue;
+        }
+        dbe->effect = effect;
+        dbe->bg = bg;
+        dbe->trap = trap;
+        dbe->obj = obj;
+        dbe->obj_mn = obj_mn;
+        dbe->mon = mon;
+        dbe->monflags = monflags;
+        dbe->branding = branding;
+        dbe->invis = !!(flags & 1);
+        dbe->visible = !!(flags & 2);
+    }
+
+    /* the runs cover the map in row-major order */
+    for (n = 0, i = 0; i < json_array_size(jruns); i++) {
+        run = json_integer_value(json_array_get(jruns, i));
+        sym = run % PACKED_RUN_MULT;
+        end = n + run / PACKED_RUN_MULT;
+        if (end > ROWNO * COLNO || sym > screen_palette_size) {
+            print_error("Strange run in cmd_update_screen_packed");
+            break;
+        }
+        if (sym)
+            for (; n < end; n++)
+                cur_dbuf[n / COLNO][n % COLNO] = screen_palette[sym - 1];
+        n = end;
+    }
+
+    cur_wndprocs.win_update_screen(cur_dbuf, ux, uy);
+    return NULL;
+}
+
 static json_t *
 cmd_delay_output(json_t * params, int display_only)
 {
@@ -585,8 +671,67 @@ cmd_list_items(json_t * params, int display_only)
     for (i = 0; i < icount; i++)
         json_read_objitem(json_array_get(jarr, i), &items[i]);
     cur_wndprocs.win_list_items(items, icount, invent);
-    free(items);
 
+    if (invent) {
+        free(cur_invent);
+        cur_invent = items;
+        cur_invent_icount = icount;
+    } else
+        free(items);
+
+    return NULL;
+}
+
+
+static json_t *
+cmd_update_inventory(json_t * params, int display_only)
+{
+    struct nh_objitem *items, *changed;
+    int icount, nchanged, i, key;
+    short oldpos[512], newpos[512];
+    json_t *jarr, *jorder;
+
+    if (json_unpack(params, "{so,so!}", "items", &jarr, "order", &jorder) ==
+        -1 || !json_is_array(jarr) || !json_is_array(jorder)) {
+        print_error("Incorrect parameter type in cmd_update_inventory");
+        return NULL;
+    }
+
+    nchanged = json_array_size(jarr);
+    changed = malloc((nchanged + 1) * sizeof (struct nh_objitem));
+    for (i = 0; i < nchanged; i++)
+        json_read_objitem(json_array_get(jarr, i), &changed[i]);
+
+    for (i = 0; i < 512; i++)
+        oldpos[i] = newpos[i] = -1;
+    for (i = 0; i < cur_invent_icount; i++)
+        oldpos[NH_OBJITEM_KEY(&cur_invent[i]) + 256] = i;
+    for (i = 0; i < nchanged; i++)
+        newpos[NH_OBJITEM_KEY(&changed[i]) + 256] = i;
+
+    icount = json_array_size(jorder);
+    items = malloc((icount + 1) * sizeof (struct nh_objitem));
+    for (i = 0; i < icount; i++) {
+        key = json_integer_value(json_array_get(jorder, i));
+        if (key < -256 || key > 255 ||
+            (newpos[key + 256] < 0 && oldpos[key + 256] < 0)) {
+            print_error("Damaged order array in cmd_update_inventory");
+            free(changed);
+            free(items);
+            return NULL;
+        }
+        if (newpos[key + 256] >= 0)
+            items[i] = changed[newpos[key + 256]];
+        else
+            items[i] = cur_invent[oldpos[key + 256]];
+    }
+    free(changed);
+
+    cur_wndprocs.win_list_items(items, icount, TRUE);
+
+    free(cur_invent);
+    cur_invent = items;
+    cur_invent_icount = icount;
     return NULL;
 }
 
@@ -233,8 +233,31 @@ struct curses_drawing_info {
     int num_effects;
 
     int bg_feature_offset;
+
+    /* Lookup tables built from the lists above once all symbol overrides
+       have been applied, so that mapglyph() doesn't need to assemble
+       symbols and colors per cell.  The effect tables are indexed with
+       NH_EFFECT_ID. */
+    struct curses_symdef *expl_table;   /* explosion symbols + type colors */
+    struct curses_symdef *zap_table;    /* zap symbols + beam colors */
+    struct curses_symdef *swallow_table;        /* + swallower colors */
+    struct curses_symdef *corpse_table; /* corpse symbol + monster colors */
+    /* NUM_BG_VARIANTS entries per bg id for the branding colors */
+    struct curses_symdef *bg_table;
+    unsigned char *bg_flags;    /* BGF_* */
 };
 
+# define BGV_PLAIN      0
+# define BGV_TRAPPED    1
+# define BGV_LOCKED     2
+# define BGV_UNLOCKED   3
+# define BGV_STEPPED    4
+# define NUM_BG_VARIANTS 5
+
+# define BGF_DOOR       0x01    /* shows locked/unlocked/trapped branding */
+# define BGF_FLOOR      0x02    /* shows stepped branding */
+# define BGF_STAIR      0x04    /* highlighted by bgbranding */
+
 /*
  * Graphics sets for display symbols
  */
@@ -344,6 +367,8 @@ extern void curses_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO],
                                  int ux, int uy);
 extern int curses_getpos(int *x, int *y, nh_bool force, const char *goal);
 extern void draw_map(int cx, int cy);
+extern void draw_map_blink(void);
+extern void invalidate_map(void);
 
 /* menu.c */
 extern void draw_menu(struct gamewin *gw);
@@ -384,12 +409,12 @@ extern void write_config(void);
 /* outchars.c */
 extern void init_displaychars(void);
 extern void free_displaychars(void);
-extern int mapglyph(struct nh_dbuf_entry *dbe, struct curses_symdef *syms,
-                    int *bg_color);
+extern int mapglyph(const struct nh_dbuf_entry *dbe,
+                    const struct curses_symdef **syms, int *bg_color);
 extern void set_rogue_level(nh_bool enable);
 extern void switch_graphics(enum nh_text_mode mode);
-extern void print_sym(WINDOW * win, struct curses_symdef *sym, int extra_attrs,
-                      int bg_color);
+extern void print_sym(WINDOW * win, const struct curses_symdef *sym,
+                      int extra_attrs, int bg_color);
 extern void curses_notify_level_changed(int dmode);
 
 /* playerselect.c */
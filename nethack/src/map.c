@@ -17,10 +17,28 @@ struct coord {
     int x, y;
 };
 
+/* What is currently shown in a map cell, and what it was drawn from.  Cells
+   are only printed again when the display buffer entry or the symbol that
+   should be shown for it changes, so an update that changes a few cells only
+   costs a few cells' worth of terminal output. */
+struct map_cell {
+    struct nh_dbuf_entry dbe;
+    int symcount;       /* > 1 for cells that blink */
+    wchar_t unichar[CCHARW_MAX + 1];
+    short ch;
+    int color, attr, bg_color;
+};
+
 static struct nh_dbuf_entry (*display_buffer)[COLNO] = NULL;
+static struct map_cell shadow[ROWNO][COLNO];
+static nh_bool shadow_valid = FALSE;
+static int blinking_cells;
+static unsigned int shadow_frame;
 static const int xdir[DIR_SELF + 1] = { -1, -1, 0, 1, 1, 1, 0, -1, 0, 0 };
 static const int ydir[DIR_SELF + 1] = { 0, -1, -1, -1, 0, 1, 1, 1, 0, 0 };
 
+static void update_map(nh_bool force, nh_bool blink_only);
+
 /* GetTickCount() returns milliseconds since the system was started, with a
  * resolution of around 15ms. gettimeofday() returns a value since the start of
  * the epoch.
@@ -57,7 +75,7 @@ get_map_key(int place_cursor)
 
     while (1) {
         key = nh_wgetch(mapwin);
-        draw_map(player.x, player.y);
+        draw_map_blink();
         doupdate();
         if (key != ERR)
             break;
@@ -73,7 +91,7 @@ void
 curses_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
 {
     display_buffer = dbuf;
-    draw_map(ux, uy);
+    update_map(FALSE, FALSE);
 
     if (ux > 0) {
         wmove(mapwin, uy, ux - 1);
@@ -84,62 +102,131 @@ curses_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
 }
 
 
-void
-draw_map(int cx, int cy)
+static unsigned int
+blink_frame(void)
+{
+    if (settings.blink)
+        return get_milliseconds() / 666;
+    return 0;
+}
+
+
+static void
+draw_cell(int x, int y, unsigned int frame, nh_bool force)
+{
+    int symcount, attr, bg_color = 0;
+    const struct curses_symdef *syms[4], *sym;
+    struct nh_dbuf_entry *dbe = &display_buffer[y][x];
+    struct map_cell *cell = &shadow[y][x];
+
+    /* nothing can have changed unless the cell blinks */
+    if (!force && cell->symcount <= 1 && !memcmp(&cell->dbe, dbe, sizeof *dbe))
+        return;
+
+    symcount = mapglyph(dbe, syms, &bg_color);
+    attr = A_NORMAL;
+    if (!(COLOR_PAIRS >= 113 || (COLORS < 16 && COLOR_PAIRS >= 57))) {
+        /* we don't have background colors available */
+        bg_color = 0;
+        if (((dbe->monflags & MON_TAME) && settings.hilite_pet) ||
+            ((dbe->monflags & MON_DETECTED) && settings.use_inverse))
+            attr |= A_REVERSE;
+    } else if (bg_color == 0) {
+        /* we do have background colors available */
+        if ((dbe->monflags & MON_DETECTED) && settings.use_inverse)
+            bg_color = CLR_MAGENTA;
+        if ((dbe->monflags & MON_PEACEFUL) && settings.hilite_pet)
+            bg_color = CLR_BROWN;
+        if ((dbe->monflags & MON_TAME) && settings.hilite_pet)
+            bg_color = CLR_BLUE;
+    }
+    sym = syms[frame % symcount];
+
+    blinking_cells += (symcount > 1) - (cell->symcount > 1);
+    cell->dbe = *dbe;
+    cell->symcount = symcount;
+
+    if (!force && cell->ch == sym->ch && cell->color == sym->color &&
+        cell->attr == attr && cell->bg_color == bg_color &&
+        !memcmp(cell->unichar, sym->unichar, sizeof cell->unichar))
+        return;
+
+    memcpy(cell->unichar, sym->unichar, sizeof cell->unichar);
+    cell->ch = sym->ch;
+    cell->color = sym->color;
+    cell->attr = attr;
+    cell->bg_color = bg_color;
+
+    /* set the position for each character to prevent incorrect positioning
+       due to charset issues (IBM chars on a unicode term or vice versa) */
+    wmove(mapwin, y, x - 1);
+    print_sym(mapwin, sym, attr, bg_color);
+}
+
+
+/* Bring the map window up to date with the display buffer.  With
+   blink_only set, only the blinking cells are looked at. */
+static void
+update_map(nh_bool force, nh_bool blink_only)
 {
-    int x, y, symcount, attr, cursx, cursy;
+    int x, y, cursx, cursy;
     unsigned int frame;
-    struct curses_symdef syms[4];
 
     if (!display_buffer || !mapwin)
         return;
 
+    frame = blink_frame();
+    if (!shadow_valid) {
+        force = TRUE;
+        blink_only = FALSE;
+    }
+    if (blink_only && (!blinking_cells || frame == shadow_frame))
+        return;
+
     getyx(mapwin, cursy, cursx);
 
-    frame = 0;
-    if (settings.blink)
-        frame = get_milliseconds() / 666;
-
-    for (y = 0; y < ROWNO; y++) {
-        for (x = 1; x < COLNO; x++) {
-            int bg_color = 0;
-
-            /* set the position for each character to prevent incorrect
-               positioning due to charset issues (IBM chars on a unicode term
-               or vice versa) */
-            wmove(mapwin, y, x - 1);
-
-            symcount = mapglyph(&display_buffer[y][x], syms, &bg_color);
-            attr = A_NORMAL;
-            if (!(COLOR_PAIRS >= 113 || (COLORS < 16 && COLOR_PAIRS >= 57))) {
-                /* we don't have background colors available */
-                bg_color = 0;
-                if (((display_buffer[y][x].monflags & MON_TAME) &&
-                     settings.hilite_pet) ||
-                    ((display_buffer[y][x].monflags & MON_DETECTED) &&
-                     settings.use_inverse))
-                    attr |= A_REVERSE;
-            } else if (bg_color == 0) {
-                /* we do have background colors available */
-                if ((display_buffer[y][x].monflags & MON_DETECTED) &&
-                    settings.use_inverse)
-                    bg_color = CLR_MAGENTA;
-                if ((display_buffer[y][x].monflags & MON_PEACEFUL) &&
-                    settings.hilite_pet)
-                    bg_color = CLR_BROWN;
-                if ((display_buffer[y][x].monflags & MON_TAME) &&
-                    settings.hilite_pet)
-                    bg_color = CLR_BLUE;
-            }
-            print_sym(mapwin, &syms[frame % symcount], attr, bg_color);
-        }
+    if (force) {
+        memset(shadow, 0, sizeof shadow);
+        blinking_cells = 0;
     }
+    for (y = 0; y < ROWNO; y++)
+        for (x = 1; x < COLNO; x++)
+            if (!blink_only || shadow[y][x].symcount > 1)
+                draw_cell(x, y, frame, force);
+
+    shadow_valid = TRUE;
+    shadow_frame = frame;
 
     wmove(mapwin, cursy, cursx);
     wnoutrefresh(mapwin);
 }
 
 
+/* Redraw the whole map, e.g. because the window was re-created or an option
+   that affects the symbols or colors changed. */
+void
+draw_map(int cx, int cy)
+{
+    update_map(TRUE, FALSE);
+}
+
+
+/* advance the animation of blinking cells */
+void
+draw_map_blink(void)
+{
+    update_map(FALSE, TRUE);
+}
+
+
+/* the map window is gone; its contents must not be trusted any more */
+void
+invalidate_map(void)
+{
+    shadow_valid = FALSE;
+}
+
+
 static int
 compare_coord_dist(const void *p1, const void *p2)
 {
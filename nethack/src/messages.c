@@ -201,7 +201,7 @@ more(void)
     wtimeout(msgwin, 666);      /* enable blinking */
     do {
         key = nh_wgetch(msgwin);
-        draw_map(player.x, player.y);
+        draw_map_blink();
         wmove(msgwin, cursy, cursx);
         doupdate();
     } while (key != '\n' && key != '\r' && key != ' ' && key != KEY_ESC);
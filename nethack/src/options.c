@@ -155,13 +155,24 @@ option_change_callback(struct nh_option_desc *option)
         curses_update_status(NULL);
     } else if (!strcmp(option->name, "darkgray")) {
         set_darkgray();
+        invalidate_map();
         draw_map(player.x, player.y);
+    } else if (!strcmp(option->name, "hilite_pet") ||
+               !strcmp(option->name, "use_inverse") ||
+               !strcmp(option->name, "floorcolor") ||
+               !strcmp(option->name, "bgbranding")) {
+        /* these change how a cell is drawn, not what's in it */
+        if (ui_flags.ingame) {
+            invalidate_map();
+            draw_map(player.x, player.y);
+        }
     } else if (!strcmp(option->name, "menu_headings")) {
         settings.menu_headings = option->value.e;
     } else if (!strcmp(option->name, "graphics")) {
         settings.graphics = option->value.e;
         switch_graphics(option->value.e);
         if (ui_flags.ingame) {
+            invalidate_map();
             draw_map(player.x, player.y);
             redraw_game_windows();
         }
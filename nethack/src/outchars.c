@@ -339,6 +339,78 @@ write_unisym_config(void)
 }
 
 
+/* Build the lookup tables used by mapglyph().  The entries share their
+   symnames with the symbol lists, so they must only be freed with free().
+   This has to happen after all overrides are applied and the special ids
+   are known. */
+static void
+build_glyph_tables(struct curses_drawing_info *di)
+{
+    int i, j;
+    struct curses_symdef *sym;
+
+    di->expl_table = malloc(di->num_expltypes * NUMEXPCHARS *
+                            sizeof (struct curses_symdef));
+    for (i = 0; i < di->num_expltypes; i++)
+        for (j = 0; j < NUMEXPCHARS; j++) {
+            sym = &di->expl_table[i * NUMEXPCHARS + j];
+            *sym = di->explsyms[j];
+            sym->color = di->expltypes[i].color;
+        }
+
+    di->zap_table = malloc(di->num_zaptypes * NUMZAPCHARS *
+                           sizeof (struct curses_symdef));
+    for (i = 0; i < di->num_zaptypes; i++)
+        for (j = 0; j < NUMZAPCHARS; j++) {
+            sym = &di->zap_table[i * NUMZAPCHARS + j];
+            *sym = di->zapsyms[j];
+            sym->color = di->zaptypes[i].color;
+        }
+
+    di->swallow_table = malloc(di->num_monsters * NUMSWALLOWCHARS *
+                               sizeof (struct curses_symdef));
+    di->corpse_table = malloc(di->num_monsters * sizeof (struct curses_symdef));
+    for (i = 0; i < di->num_monsters; i++) {
+        for (j = 0; j < NUMSWALLOWCHARS; j++) {
+            sym = &di->swallow_table[i * NUMSWALLOWCHARS + j];
+            *sym = di->swallowsyms[j];
+            sym->color = di->monsters[i].color;
+        }
+        di->corpse_table[i] = di->objects[corpse_id];
+        di->corpse_table[i].color = di->monsters[i].color;
+    }
+
+    di->bg_table = malloc(di->num_bgelements * NUM_BG_VARIANTS *
+                          sizeof (struct curses_symdef));
+    di->bg_flags = calloc(di->num_bgelements, 1);
+    for (i = 0; i < di->num_bgelements; i++) {
+        sym = &di->bg_table[i * NUM_BG_VARIANTS];
+        for (j = 0; j < NUM_BG_VARIANTS; j++)
+            sym[j] = di->bgelements[i];
+
+        if (i == vcdoor_id || i == hcdoor_id) {
+            di->bg_flags[i] |= BGF_DOOR;
+            sym[BGV_TRAPPED].color = CLR_CYAN;
+            sym[BGV_LOCKED].color = CLR_RED;
+            sym[BGV_UNLOCKED].color = CLR_GREEN;
+        }
+        /* stepped-on squares are shown in a different color, so the player
+           can see where they stepped */
+        if (i == darkroom_id) {
+            di->bg_flags[i] |= BGF_FLOOR;
+            sym[BGV_STEPPED].color = CLR_BLUE;
+        } else if (i == room_id || i == ndoor_id || i == corr_id ||
+                   i == litcorr_id) {
+            di->bg_flags[i] |= BGF_FLOOR;
+            sym[BGV_STEPPED].color = CLR_BROWN;
+        }
+        if (i == upstair_id || i == dnstair_id || i == upladder_id ||
+            i == dnladder_id || i == upsstair_id || i == dnsstair_id)
+            di->bg_flags[i] |= BGF_STAIR;
+    }
+}
+
+
 void
 init_displaychars(void)
 {
@@ -398,6 +470,10 @@ init_displaychars(void)
             vibsquare_id = i;
     }
 
+    build_glyph_tables(default_drawing);
+    build_glyph_tables(unicode_drawing);
+    build_glyph_tables(rogue_drawing);
+
     /* options are parsed before display is initialized, so redo switch */
     switch_graphics(settings.graphics);
 }
@@ -431,6 +507,13 @@ free_drawing_info(struct curses_drawing_info *di)
     free_symarray(di->zapsyms, NUMZAPCHARS);
     free_symarray(di->swallowsyms, NUMSWALLOWCHARS);
 
+    free(di->expl_table);
+    free(di->zap_table);
+    free(di->swallow_table);
+    free(di->corpse_table);
+    free(di->bg_table);
+    free(di->bg_flags);
+
     free(di);
 }
 
@@ -449,32 +532,29 @@ free_displaychars(void)
 
 
 int
-mapglyph(struct nh_dbuf_entry *dbe, struct curses_symdef *syms, int *bg_color)
+mapglyph(const struct nh_dbuf_entry *dbe, const struct curses_symdef **syms,
+         int *bg_color)
 {
-    int id, count = 0;
+    int id, flags, variant, count = 0;
 
     if (dbe->effect) {
         id = NH_EFFECT_ID(dbe->effect);
 
         switch (NH_EFFECT_TYPE(dbe->effect)) {
         case E_EXPLOSION:
-            syms[0] = cur_drawing->explsyms[id % NUMEXPCHARS];
-            syms[0].color = cur_drawing->expltypes[id / NUMEXPCHARS].color;
+            syms[0] = &cur_drawing->expl_table[id];
             break;
 
         case E_SWALLOW:
-            syms[0] = cur_drawing->swallowsyms[id & 0x7];
-            syms[0].color = cur_drawing->monsters[id >> 3].color;
+            syms[0] = &cur_drawing->swallow_table[id];
             break;
 
         case E_ZAP:
-            syms[0] = cur_drawing->zapsyms[id & 0x3];
-            syms[0].color = cur_drawing->zaptypes[id >> 2].color;
+            syms[0] = &cur_drawing->zap_table[id];
             break;
 
         case E_MISC:
-            syms[0] = cur_drawing->effects[id];
-            syms[0].color = cur_drawing->effects[id].color;
+            syms[0] = &cur_drawing->effects[id];
             break;
         }
 
@@ -482,34 +562,32 @@ mapglyph(struct nh_dbuf_entry *dbe, struct curses_symdef *syms, int *bg_color)
     }
 
     if (dbe->invis)
-        syms[count++] = cur_drawing->invis[0];
+        syms[count++] = &cur_drawing->invis[0];
 
     else if (dbe->mon) {
         if (dbe->mon > cur_drawing->num_monsters &&
             (dbe->monflags & MON_WARNING)) {
             id = dbe->mon - 1 - cur_drawing->num_monsters;
-            syms[count++] = cur_drawing->warnings[id];
+            syms[count++] = &cur_drawing->warnings[id];
         } else {
             id = dbe->mon - 1;
-            syms[count++] = cur_drawing->monsters[id];
+            syms[count++] = &cur_drawing->monsters[id];
         }
     }
 
     if (dbe->obj) {
         id = dbe->obj - 1;
-        if (id == corpse_id) {
-            syms[count] = cur_drawing->objects[id];
-            syms[count].color = cur_drawing->monsters[dbe->obj_mn - 1].color;
-            count++;
-        } else
-            syms[count++] = cur_drawing->objects[id];
+        if (id == corpse_id)
+            syms[count++] = &cur_drawing->corpse_table[dbe->obj_mn - 1];
+        else
+            syms[count++] = &cur_drawing->objects[id];
     }
 
     if (dbe->trap) {
         id = dbe->trap - 1;
-        syms[count++] = cur_drawing->traps[id];
+        syms[count++] = &cur_drawing->traps[id];
         if (settings.bgbranding) {
-            if (dbe->trap == mportal_id + 1 || dbe->trap == vibsquare_id + 1)
+            if (id == mportal_id || id == vibsquare_id)
                 *bg_color = CLR_RED;
             else
                 *bg_color = CLR_CYAN;
@@ -518,35 +596,26 @@ mapglyph(struct nh_dbuf_entry *dbe, struct curses_symdef *syms, int *bg_color)
 
     /* omit the background symbol from the list if it is boring */
     if (count == 0 || dbe->bg >= cur_drawing->bg_feature_offset) {
-        syms[count++] = cur_drawing->bgelements[dbe->bg];
-        /* overrides for branding; note that although we're told whether open
-           doors are locked/unlocked, it doesn't make much sense to display
-           that */
-        if (dbe->bg == vcdoor_id || dbe->bg == hcdoor_id) {
+        /* pick the color variant for branding; note that although we're told
+           whether open doors are locked/unlocked, it doesn't make much sense
+           to display that */
+        flags = cur_drawing->bg_flags[dbe->bg];
+        variant = BGV_PLAIN;
+        if (flags & BGF_DOOR) {
             if (dbe->branding & NH_BRANDING_TRAPPED)
-                syms[count - 1].color = CLR_CYAN;
+                variant = BGV_TRAPPED;
             else if (dbe->branding & NH_BRANDING_LOCKED)
-                syms[count - 1].color = CLR_RED;
+                variant = BGV_LOCKED;
             else if (dbe->branding & NH_BRANDING_UNLOCKED)
-                syms[count - 1].color = CLR_GREEN;
-        }
-        /* Override darkroom for stepped-on squares, so the player can see
-           where they stepped. */
-        if (settings.floorcolor) {
-            if (dbe->bg == darkroom_id && dbe->branding & NH_BRANDING_STEPPED)
-                syms[count - 1].color = CLR_BLUE;
-            if ((dbe->bg == room_id || dbe->bg == ndoor_id || dbe->bg == corr_id
-                 || dbe->bg == litcorr_id)
-                && dbe->branding & NH_BRANDING_STEPPED) {
-                syms[count - 1].color = CLR_BROWN;
-            }
-        }
-        if (dbe->bg == upstair_id || dbe->bg == dnstair_id ||
-            dbe->bg == upladder_id || dbe->bg == dnladder_id ||
-            dbe->bg == upsstair_id || dbe->bg == dnsstair_id) {
-            if (settings.bgbranding)
-                *bg_color = CLR_RED;
-        }
+                variant = BGV_UNLOCKED;
+        } else if ((flags & BGF_FLOOR) && settings.floorcolor &&
+                   (dbe->branding & NH_BRANDING_STEPPED))
+            variant = BGV_STEPPED;
+
+        syms[count++] =
+            &cur_drawing->bg_table[dbe->bg * NUM_BG_VARIANTS + variant];
+        if ((flags & BGF_STAIR) && settings.bgbranding)
+            *bg_color = CLR_RED;
     }
 
     return count;       /* count <= 4 */
@@ -591,7 +660,8 @@ switch_graphics(enum nh_text_mode mode)
 
 
 void
-print_sym(WINDOW * win, struct curses_symdef *sym, int extra_attrs, int bgcolor)
+print_sym(WINDOW * win, const struct curses_symdef *sym, int extra_attrs,
+          int bgcolor)
 {
     int attr;
     cchar_t uni_out;
@@ -313,6 +313,7 @@ destroy_game_windows(void)
             delwin(sidebar);
         }
         msgwin = mapwin = statuswin = sidebar = NULL;
+        invalidate_map();
     }
 
     ui_flags.ingame = FALSE;
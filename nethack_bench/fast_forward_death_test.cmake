@@ -0,0 +1,35 @@
+# Plays games with the fast_forward option in which the hero dies in the
+# middle of a fast-forwarded command, checks that a game ended that way, and
+# replays the games, which must not desync.
+#
+# Expects BENCH (the nethack_bench binary), REPLAYBATCH, SCRIPT, DATADIR
+# (where nhdat is) and WORKDIR to be set on the command line.
+
+file (REMOVE_RECURSE ${WORKDIR})
+file (MAKE_DIRECTORY ${WORKDIR})
+# rotten rations and throwing up instead of choking depend on the seed
+execute_process (COMMAND ${BENCH} -d ${DATADIR} -r Archeologist -n 3 -a 20
+                         -f ${SCRIPT} -y n -O fast_forward=10 -k ${WORKDIR}
+                 RESULT_VARIABLE result OUTPUT_QUIET)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "nethack_bench failed")
+endif ()
+
+# a finished game whose last command went on for at least one step
+set (died FALSE)
+file (GLOB logs ${WORKDIR}/*.nhgame)
+foreach (log ${logs})
+    file (READ ${log} contents)
+    if (contents MATCHES "^NHGAME done" AND contents MATCHES "\n\\*[^>]*$")
+        set (died TRUE)
+    endif ()
+endforeach ()
+if (NOT died)
+    message (FATAL_ERROR "no game ended in a fast-forwarded step")
+endif ()
+
+execute_process (COMMAND ${REPLAYBATCH} -d ${DATADIR} ${WORKDIR}
+                 RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "the games did not replay without desyncs")
+endif ()
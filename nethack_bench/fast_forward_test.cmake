@@ -0,0 +1,35 @@
+# Plays games with the fast_forward option in which a yes/no question is
+# answered in the middle of an occupation, checks that the answer is logged
+# between two steps, and replays the games, which must not desync.
+#
+# Expects BENCH (the nethack_bench binary), REPLAYBATCH, SCRIPT, DATADIR
+# (where nhdat is) and WORKDIR to be set on the command line.
+
+file (REMOVE_RECURSE ${WORKDIR})
+file (MAKE_DIRECTORY ${WORKDIR})
+# how full the hero is depends on rotten apples, so a few seeds are played
+execute_process (COMMAND ${BENCH} -d ${DATADIR} -r Monk -n 5 -a 6
+                         -f ${SCRIPT} -y n -O fast_forward=10 -k ${WORKDIR}
+                 RESULT_VARIABLE result OUTPUT_QUIET)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "nethack_bench failed")
+endif ()
+
+# a step, the 'n' to "Stop eating?", and another step
+set (prompted FALSE)
+file (GLOB logs ${WORKDIR}/*.nhgame)
+foreach (log ${logs})
+    file (READ ${log} contents)
+    if (contents MATCHES "\n\\* y:6e\n\\*")
+        set (prompted TRUE)
+    endif ()
+endforeach ()
+if (NOT prompted)
+    message (FATAL_ERROR "no game was asked a question partway through a meal")
+endif ()
+
+execute_process (COMMAND ${REPLAYBATCH} -d ${DATADIR} -s ${WORKDIR}
+                 RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "the games did not replay without desyncs")
+endif ()
@@ -0,0 +1,35 @@
+# Plays a game in which one inventory item changes and checks that the window
+# port gets small update_inventory calls instead of the whole list again.
+#
+# Expects BENCH (the nethack_bench binary), SCRIPT, DATADIR (where nhdat is)
+# and WORKDIR to be set on the command line.
+
+file (REMOVE_RECURSE ${WORKDIR})
+file (MAKE_DIRECTORY ${WORKDIR})
+execute_process (COMMAND ${BENCH} -d ${DATADIR} -r Archeologist -a 6
+                         -f ${SCRIPT} -J -o ${WORKDIR}/result.json
+                 RESULT_VARIABLE result OUTPUT_QUIET)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "nethack_bench failed")
+endif ()
+
+file (READ ${WORKDIR}/result.json json)
+set (pattern "\"inventory\": {\"lists\": ([0-9]+), ")
+set (pattern "${pattern}\"updates\": ([0-9]+), \"max_changed\": ([0-9]+)}")
+string (REGEX MATCH "${pattern}" match "${json}")
+if (NOT match)
+    message (FATAL_ERROR "no inventory counts in the results")
+endif ()
+set (lists ${CMAKE_MATCH_1})
+set (updates ${CMAKE_MATCH_2})
+set (max_changed ${CMAKE_MATCH_3})
+# the first update of the game may be a full list, nothing after it
+if (lists GREATER 1)
+    message (FATAL_ERROR "the whole inventory was sent ${lists} times")
+endif ()
+if (updates EQUAL 0)
+    message (FATAL_ERROR "eating sent no update_inventory")
+endif ()
+if (max_changed GREATER 3)
+    message (FATAL_ERROR "an update_inventory had ${max_changed} entries")
+endif ()
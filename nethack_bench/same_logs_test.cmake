@@ -0,0 +1,51 @@
+# Plays the same games with an option that must not change the game off and
+# on, and checks that the logs, and so every save written into them, are byte
+# for byte the same.  The walk takes the stairs both ways, so levels are left
+# and visited again.
+#
+# Expects BENCH (the nethack_bench binary), DATADIR (where nhdat is), WORKDIR
+# and OPTION (the option's name; it is set to 0 and 1) to be set on the
+# command line.  If COUNTER is set too, that benchmark counter must be above
+# zero with the option on, to show that it had something to do.
+
+file (REMOVE_RECURSE ${WORKDIR})
+foreach (value 0 1)
+    file (MAKE_DIRECTORY ${WORKDIR}/${value})
+    execute_process (COMMAND ${BENCH} -d ${DATADIR} -n 3 -a 3000 -u -J
+                             -O ${OPTION}=${value} -k ${WORKDIR}/${value}
+                             -o ${WORKDIR}/${value}.json
+                     RESULT_VARIABLE result OUTPUT_QUIET)
+    if (NOT result EQUAL 0)
+        message (FATAL_ERROR "nethack_bench failed with ${OPTION}=${value}")
+    endif ()
+endforeach ()
+
+file (GLOB logs RELATIVE ${WORKDIR}/0 ${WORKDIR}/0/*.nhgame)
+if (NOT logs)
+    message (FATAL_ERROR "nethack_bench left no logs in ${WORKDIR}/0")
+endif ()
+foreach (log ${logs})
+    file (READ ${WORKDIR}/0/${log} off)
+    file (READ ${WORKDIR}/1/${log} on)
+    # the option lines are the only ones that may differ
+    string (REGEX REPLACE "\n![^\n]*" "" off "${off}")
+    string (REGEX REPLACE "\n![^\n]*" "" on "${on}")
+    if (NOT off STREQUAL on)
+        message (FATAL_ERROR "${log} differs with ${OPTION}=1")
+    endif ()
+endforeach ()
+
+if (COUNTER)
+    file (READ ${WORKDIR}/1.json json)
+    # the last match is the total of all games
+    string (REGEX MATCHALL "\"${COUNTER}\": [0-9]+" counts "${json}")
+    list (LENGTH counts n)
+    if (n EQUAL 0)
+        message (FATAL_ERROR "no ${COUNTER} in the results")
+    endif ()
+    math (EXPR last "${n} - 1")
+    list (GET counts ${last} total)
+    if (total MATCHES ": 0$")
+        message (FATAL_ERROR "${COUNTER} is 0 with ${OPTION}=1")
+    endif ()
+endif ()
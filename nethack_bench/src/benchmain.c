@@ -0,0 +1,777 @@
+/* vim:set cin ft=c sw=4 sts=4 ts=8 et ai cino=Ls\:0t0(0 : -*- mode:c;fill-column:80;tab-width:8;c-basic-offset:4;indent-tabs-mode:nil;c-file-style:"k&r" -*-*/
+/* NetHack may be freely redistributed.  See license for details. */
+
+/* nethack_bench: a headless benchmark for the game core.
+ *
+ * Plays one or more games with fixed seeds through window procs that never
+ * draw anything or wait for input, driving them either with a seeded random
+ * walk or with a command script.  The same seed, script and library build
+ * always produce the same game, so the numbers from two builds of libnethack
+ * can be compared directly.  Per-phase timings come from the hooks in
+ * libnethack/src/bench.c. */
+
+#define _XOPEN_SOURCE 700
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nethack.h"
+
+#define DEFAULT_ACTIONS 2000
+#define MAX_SCRIPT_LINES 4096
+#define MAX_GAME_OPTIONS 16
+
+/* start time of every benchmark game: a Tuesday with a waxing moon, so neither
+   the full/new moon nor Friday the 13th changes luck or messages */
+#define BENCH_GAMETIME 1357041600ULL
+
+static const char *const phase_names[BENCH_PHASE_COUNT] = {
+    "level_creation", "movemon", "vision", "flush_screen",
+    "log_command_result", "pregen_take"
+};
+
+static const char *const counter_names[BENCH_COUNTER_COUNT] = {
+    "monlist_walks", "nearby_monsters", "pregen_hits", "pregen_misses"
+};
+
+static const char *const dir_names[] = {
+    "w", "nw", "n", "ne", "e", "se", "s", "sw", "up", "down", "self"
+};
+
+struct script_cmd {
+    char name[20];
+    int count;
+    struct nh_cmd_arg arg;
+};
+
+struct game_result {
+    unsigned int seed;
+    const char *role;
+    int actions, moves, max_depth, level_changes;
+    int invent_lists, invent_updates, invent_max_changed;
+    int status;
+    unsigned long long start_nsec, run_nsec;
+    struct nh_bench_stats stats;
+};
+
+/* what the null window procs have seen of the game */
+static struct {
+    int moves, depth, max_depth, level_changes;
+    int invent_lists, invent_updates, invent_max_changed;
+    nh_bool on_dnstair, on_upstair;
+} seen;
+
+static int dnstair_id = -1, upstair_id = -1;
+static unsigned int walk_state;
+static nh_bool walk_up;
+static char yn_answer;
+
+static struct script_cmd *script;
+static int script_len;
+
+
+/* ------------------------------------------------------------------------- */
+/* window procs: answer every question with "no" or "cancel", or yes/no
+   questions with the -y answer */
+
+static void
+null_pause(enum nh_pause_reason reason)
+{
+}
+
+static void
+null_display_buffer(const char *buf, nh_bool trymove)
+{
+}
+
+static void
+null_update_status(struct nh_player_info *pi)
+{
+    seen.moves = pi->moves;
+    seen.depth = pi->z;
+    if (pi->z > seen.max_depth)
+        seen.max_depth = pi->z;
+}
+
+static void
+null_print_message(int turn, const char *msg)
+{
+}
+
+static int
+null_display_menu(struct nh_menuitem *items, int icount, const char *title,
+                  int how, int placement_hint, int *results)
+{
+    return 0;
+}
+
+static int
+null_display_objects(struct nh_objitem *items, int icount, const char *title,
+                     int how, int placement_hint, struct nh_objresult *pick_list)
+{
+    return 0;
+}
+
+static nh_bool
+null_list_items(struct nh_objitem *items, int icount, nh_bool invent)
+{
+    if (invent)
+        seen.invent_lists++;
+    return TRUE;
+}
+
+static void
+null_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
+{
+    if (ux >= 0 && uy >= 0) {
+        seen.on_dnstair = dbuf[uy][ux].bg == dnstair_id;
+        seen.on_upstair = dbuf[uy][ux].bg == upstair_id;
+    }
+}
+
+static void
+null_raw_print(const char *str)
+{
+}
+
+static char
+null_query_key(const char *query, int *count)
+{
+    if (count)
+        *count = -1;
+    return '\033';
+}
+
+static int
+null_getpos(int *x, int *y, nh_bool force, const char *goal)
+{
+    /* a forced getpos loops until it gets a position on the map */
+    if (force && (*x < 1 || *y < 1 || *x > COLNO || *y > ROWNO))
+        *x = *y = 1;
+    return force ? 0 : -1;
+}
+
+static enum nh_direction
+null_getdir(const char *query, nh_bool restricted)
+{
+    return DIR_NONE;
+}
+
+static char
+null_yn_function(const char *query, const char *rset, char defchoice)
+{
+    if (yn_answer && strchr(rset, yn_answer))
+        return yn_answer;
+    return defchoice ? defchoice : '\033';
+}
+
+static void
+null_getlin(const char *query, char *buf)
+{
+    strcpy(buf, "\033");
+}
+
+static void
+null_delay(void)
+{
+}
+
+static void
+null_level_changed(int displaymode)
+{
+    seen.level_changes++;
+}
+
+static void
+null_outrip(struct nh_menuitem *items, int icount, nh_bool tombstone,
+            const char *name, int gold, const char *killbuf, int end_how,
+            int year)
+{
+}
+
+static void
+null_update_inventory(struct nh_objitem *changed, int nchanged, int *order,
+                      int icount)
+{
+    seen.invent_updates++;
+    if (nchanged > seen.invent_max_changed)
+        seen.invent_max_changed = nchanged;
+}
+
+static struct nh_window_procs bench_windowprocs = {
+    null_pause,
+    null_display_buffer,
+    null_update_status,
+    null_print_message,
+    null_display_menu,
+    null_display_objects,
+    null_list_items,
+    null_update_screen,
+    null_raw_print,
+    null_query_key,
+    null_getpos,
+    null_getdir,
+    null_yn_function,
+    null_getlin,
+    null_delay,
+    null_level_changed,
+    null_outrip,
+    null_print_message,
+    null_update_inventory,
+};
+
+
+/* ------------------------------------------------------------------------- */
+
+static unsigned long long
+wallclock(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/* xorshift32; deliberately independent of the game's own RNG */
+static unsigned int
+walk_random(void)
+{
+    walk_state ^= walk_state << 13;
+    walk_state ^= walk_state >> 17;
+    walk_state ^= walk_state << 5;
+    return walk_state;
+}
+
+
+static void
+set_cmd(struct script_cmd *c, const char *name, int count,
+        enum nh_direction dir)
+{
+    strncpy(c->name, name, sizeof (c->name) - 1);
+    c->name[sizeof (c->name) - 1] = '\0';
+    c->count = count;
+    if (dir == DIR_NONE) {
+        c->arg.argtype = CMD_ARG_NONE;
+    } else {
+        c->arg.argtype = CMD_ARG_DIR;
+        c->arg.d = dir;
+    }
+}
+
+
+/* The random walk mostly wanders and explores, searches now and then, and
+ * takes the stairs down when it finds itself on them, so that long runs
+ * exercise level creation as well as the per-turn code.  With -u it also
+ * takes the stairs up, so that levels are left and visited again. */
+static void
+next_walk_cmd(struct script_cmd *c)
+{
+    unsigned int r = walk_random() % 100;
+
+    if (seen.on_dnstair && r < 50)
+        set_cmd(c, "move", 0, DIR_DOWN);
+    else if (walk_up && seen.on_upstair && seen.depth > 1 && r < 30)
+        set_cmd(c, "move", 0, DIR_UP);
+    else if (r < 55)
+        set_cmd(c, "search", 5, DIR_NONE);
+    else if (r < 70)
+        set_cmd(c, "autoexplore", 0, DIR_NONE);
+    else if (r < 75)
+        set_cmd(c, "run", 0, (enum nh_direction)(walk_random() % 8));
+    else
+        set_cmd(c, "move", 0, (enum nh_direction)(walk_random() % 8));
+}
+
+
+/* script lines look like "<command> [count] [direction | o:<letter>]", e.g.
+ * "search 10", "move sw" or "eat o:f"; '#' starts a comment.  Multi-word
+ * command names are written with '_' instead of spaces ("move_nopickup"). */
+static int
+load_script(const char *filename)
+{
+    FILE *fp;
+    char line[256], *tok, *p;
+    int lineno = 0, d;
+
+    fp = fopen(filename, "r");
+    if (!fp) {
+        fprintf(stderr, "Error: could not open %s: %s\n", filename,
+                strerror(errno));
+        return FALSE;
+    }
+
+    script = malloc(MAX_SCRIPT_LINES * sizeof (struct script_cmd));
+    script_len = 0;
+    while (fgets(line, sizeof (line), fp) && script_len < MAX_SCRIPT_LINES) {
+        struct script_cmd *c = &script[script_len];
+        enum nh_direction dir = DIR_NONE;
+        int count = 0;
+        char invlet = 0;
+
+        lineno++;
+        if ((p = strchr(line, '#')))
+            *p = '\0';
+        tok = strtok(line, " \t\r\n");
+        if (!tok)
+            continue;
+        for (p = tok; *p; p++)
+            if (*p == '_')
+                *p = ' ';
+        set_cmd(c, tok, 0, DIR_NONE);
+
+        while ((tok = strtok(NULL, " \t\r\n"))) {
+            if (isdigit((unsigned char)*tok)) {
+                count = atoi(tok);
+                continue;
+            }
+            if (!strncmp(tok, "o:", 2) && tok[2] && !tok[3]) {
+                invlet = tok[2];
+                continue;
+            }
+            for (d = 0; d <= DIR_SELF; d++)
+                if (!strcasecmp(tok, dir_names[d]))
+                    break;
+            if (d > DIR_SELF) {
+                fprintf(stderr, "%s:%d: unknown direction \"%s\"\n",
+                        filename, lineno, tok);
+                fclose(fp);
+                return FALSE;
+            }
+            dir = (enum nh_direction)d;
+        }
+        set_cmd(c, c->name, count, dir);
+        if (invlet) {
+            c->arg.argtype = CMD_ARG_OBJ;
+            c->arg.invlet = invlet;
+        }
+        script_len++;
+    }
+    fclose(fp);
+
+    if (!script_len) {
+        fprintf(stderr, "Error: %s contains no commands\n", filename);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
+/* find the first valid character for the given role; with no role name the
+ * role is picked from the seed so that a batch of games covers all of them */
+static nh_bool
+pick_character(const char *rolename, unsigned int seed, int *role, int *race,
+               int *gend, int *align)
+{
+    struct nh_roles_info *ri = nh_get_roles();
+    int r;
+
+    if (rolename) {
+        for (r = 0; r < ri->num_roles; r++)
+            if (!strncasecmp(ri->rolenames_m[r], rolename, strlen(rolename)))
+                break;
+        if (r == ri->num_roles)
+            return FALSE;
+    } else
+        r = seed % ri->num_roles;
+
+    *role = r;
+    for (*race = 0; *race < ri->num_races; (*race)++)
+        for (*gend = 0; *gend < ri->num_genders; (*gend)++)
+            for (*align = 0; *align < ri->num_aligns; (*align)++)
+                if (ri->matrix[nh_cm_idx(*ri, r, *race, *gend, *align)])
+                    return TRUE;
+    return FALSE;
+}
+
+
+/* The log of a game is kept in keepdir if that is given, and thrown away
+   with the work directory otherwise. */
+static nh_bool
+run_game(unsigned int seed, const char *rolename, int max_actions,
+         const char *workdir, const char *keepdir, struct game_result *res)
+{
+    struct nh_roles_info *ri = nh_get_roles();
+    struct script_cmd c;
+    char logname[4096];
+    int fd, role, race, gend, align, status = READY_FOR_INPUT, step = 0;
+    unsigned long long t0, t1;
+
+    memset(res, 0, sizeof (*res));
+    memset(&seen, 0, sizeof (seen));
+    res->seed = seed;
+    walk_state = seed ? seed : 0x9e3779b9;
+
+    if (!pick_character(rolename, seed, &role, &race, &gend, &align)) {
+        fprintf(stderr, "Error: no valid character for role \"%s\"\n",
+                rolename);
+        return FALSE;
+    }
+    res->role = ri->rolenames_m[role];
+
+    snprintf(logname, sizeof (logname), "%s/bench_%u.nhgame",
+             keepdir ? keepdir : workdir, seed);
+    fd = open(logname, O_TRUNC | O_CREAT | O_RDWR, 0660);
+    if (fd == -1) {
+        fprintf(stderr, "Error: could not create %s: %s\n", logname,
+                strerror(errno));
+        return FALSE;
+    }
+
+    nh_bench_fix_seed(TRUE, seed, BENCH_GAMETIME);
+    nh_bench_reset();
+
+    t0 = wallclock();
+    if (!nh_start_game(fd, "bench", role, race, gend, align, MODE_NORMAL)) {
+        fprintf(stderr, "Error: could not start game with seed %u\n", seed);
+        close(fd);
+        return FALSE;
+    }
+    t1 = wallclock();
+    res->start_nsec = t1 - t0;
+    /* only count the inventory updates of the commands */
+    seen.invent_lists = seen.invent_updates = seen.invent_max_changed = 0;
+
+    while (res->actions < max_actions && status < GAME_OVER) {
+        if (status == READY_FOR_INPUT) {
+            if (script)
+                c = script[step++ % script_len];
+            else
+                next_walk_cmd(&c);
+            status = nh_command(c.name, c.count, &c.arg);
+        } else {
+            /* let a multi-turn command or occupation carry on */
+            c.arg.argtype = CMD_ARG_NONE;
+            status = nh_command(NULL, 0, &c.arg);
+        }
+        res->actions++;
+    }
+    res->run_nsec = wallclock() - t1;
+    res->status = status;
+
+    nh_bench_get_stats(&res->stats);
+    res->moves = seen.moves;
+    res->max_depth = seen.max_depth;
+    res->level_changes = seen.level_changes;
+    res->invent_lists = seen.invent_lists;
+    res->invent_updates = seen.invent_updates;
+    res->invent_max_changed = seen.invent_max_changed;
+
+    /* saving is the quickest way out that leaves no score or bones behind */
+    if (status < GAME_OVER)
+        nh_exit_game(EXIT_FORCE_SAVE);
+
+    close(fd);
+    if (!keepdir)
+        unlink(logname);
+    return TRUE;
+}
+
+
+/* ------------------------------------------------------------------------- */
+/* output */
+
+static void
+print_text(FILE *out, struct game_result *results, int ngames)
+{
+    struct nh_bench_stats total;
+    unsigned long long run_nsec = 0;
+    int g, p, actions = 0;
+
+    memset(&total, 0, sizeof (total));
+    for (g = 0; g < ngames; g++) {
+        struct game_result *r = &results[g];
+
+        fprintf(out, "seed %u (%s): %d actions, %d turns, depth %d, "
+                "%.1f ms (%.0f actions/sec)%s\n", r->seed, r->role, r->actions,
+                r->moves, r->max_depth, r->run_nsec / 1e6,
+                r->run_nsec ? r->actions * 1e9 / r->run_nsec : 0.0,
+                r->status == GAME_OVER ? " [died]" : "");
+        for (p = 0; p < BENCH_PHASE_COUNT; p++) {
+            total.calls[p] += r->stats.calls[p];
+            total.nsec[p] += r->stats.nsec[p];
+        }
+        for (p = 0; p < BENCH_COUNTER_COUNT; p++)
+            total.count[p] += r->stats.count[p];
+        run_nsec += r->run_nsec;
+        actions += r->actions;
+    }
+
+    fprintf(out, "\n%-20s %10s %12s %10s\n", "phase", "calls", "total ms",
+            "us/call");
+    for (p = 0; p < BENCH_PHASE_COUNT; p++)
+        fprintf(out, "%-20s %10llu %12.1f %10.2f\n", phase_names[p],
+                total.calls[p], total.nsec[p] / 1e6,
+                total.calls[p] ? total.nsec[p] / 1e3 / total.calls[p] : 0.0);
+    fprintf(out, "\n%-20s %10s\n", "counter", "count");
+    for (p = 0; p < BENCH_COUNTER_COUNT; p++)
+        fprintf(out, "%-20s %10llu\n", counter_names[p], total.count[p]);
+    fprintf(out, "\n%d actions in %.1f ms (%.0f actions/sec)\n", actions,
+            run_nsec / 1e6, run_nsec ? actions * 1e9 / run_nsec : 0.0);
+}
+
+
+static void
+print_json_phases(FILE *out, const struct nh_bench_stats *stats)
+{
+    int p;
+
+    fprintf(out, "{");
+    for (p = 0; p < BENCH_PHASE_COUNT; p++)
+        fprintf(out, "%s\"%s\": {\"calls\": %llu, \"nsec\": %llu}",
+                p ? ", " : "", phase_names[p], stats->calls[p],
+                stats->nsec[p]);
+    fprintf(out, "}");
+}
+
+
+static void
+print_json_counters(FILE *out, const struct nh_bench_stats *stats)
+{
+    int p;
+
+    fprintf(out, "{");
+    for (p = 0; p < BENCH_COUNTER_COUNT; p++)
+        fprintf(out, "%s\"%s\": %llu", p ? ", " : "", counter_names[p],
+                stats->count[p]);
+    fprintf(out, "}");
+}
+
+
+static void
+print_json(FILE *out, struct game_result *results, int ngames,
+           const char *mode, int max_actions)
+{
+    struct nh_bench_stats total;
+    unsigned long long run_nsec = 0;
+    int g, p, actions = 0;
+
+    memset(&total, 0, sizeof (total));
+    fprintf(out, "{\n  \"version\": \"%d.%d.%d\",\n", VERSION_MAJOR,
+            VERSION_MINOR, PATCHLEVEL);
+    fprintf(out, "  \"mode\": \"%s\",\n  \"max_actions\": %d,\n", mode,
+            max_actions);
+    fprintf(out, "  \"games\": [\n");
+    for (g = 0; g < ngames; g++) {
+        struct game_result *r = &results[g];
+
+        fprintf(out, "    {\"seed\": %u, \"role\": \"%s\", \"actions\": %d, "
+                "\"turns\": %d, \"max_depth\": %d, \"level_changes\": %d, "
+                "\"died\": %s, \"start_nsec\": %llu, \"run_nsec\": %llu, "
+                "\"phases\": ", r->seed, r->role, r->actions, r->moves,
+                r->max_depth, r->level_changes,
+                r->status == GAME_OVER ? "true" : "false", r->start_nsec,
+                r->run_nsec);
+        print_json_phases(out, &r->stats);
+        fprintf(out, ", \"counters\": ");
+        print_json_counters(out, &r->stats);
+        fprintf(out, ", \"inventory\": {\"lists\": %d, \"updates\": %d, "
+                "\"max_changed\": %d}", r->invent_lists, r->invent_updates,
+                r->invent_max_changed);
+        fprintf(out, "}%s\n", g + 1 < ngames ? "," : "");
+
+        for (p = 0; p < BENCH_PHASE_COUNT; p++) {
+            total.calls[p] += r->stats.calls[p];
+            total.nsec[p] += r->stats.nsec[p];
+        }
+        for (p = 0; p < BENCH_COUNTER_COUNT; p++)
+            total.count[p] += r->stats.count[p];
+        run_nsec += r->run_nsec;
+        actions += r->actions;
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"total\": {\"actions\": %d, \"run_nsec\": %llu, "
+            "\"phases\": ", actions, run_nsec);
+    print_json_phases(out, &total);
+    fprintf(out, ", \"counters\": ");
+    print_json_counters(out, &total);
+    fprintf(out, "}\n}\n");
+}
+
+
+/* ------------------------------------------------------------------------- */
+
+static int
+remove_entry(const char *path, const struct stat *sb, int flag,
+             struct FTW *ftwbuf)
+{
+    remove(path);
+    return 0;
+}
+
+
+static void
+print_usage(const char *progname)
+{
+    printf("Usage: %s [OPTIONS]\n", progname);
+    printf("  -a <number>      Actions (calls to nh_command) per game."
+           " Default: %d\n", DEFAULT_ACTIONS);
+    printf("  -d <directory>   Directory containing nhdat."
+           " Default: \"" NETHACKDIR "\"\n");
+    printf("  -f <file name>   Run this command script instead of a random"
+           " walk.\n");
+    printf("  -J               Print the results as JSON.\n");
+    printf("  -k <directory>   Keep the log of each game in this directory.\n");
+    printf("  -n <number>      Number of games; seeds are consecutive."
+           " Default: 1\n");
+    printf("  -O <name=value>  Set a game option; may be given %d times.\n",
+           MAX_GAME_OPTIONS);
+    printf("  -o <file name>   Write the results to this file.\n");
+    printf("  -r <role>        Play this role. Default: chosen by seed.\n");
+    printf("  -s <number>      Seed of the first game. Default: 1\n");
+    printf("  -u               Let the random walk take the stairs up, too.\n");
+    printf("  -y <character>   Answer yes/no questions with this if allowed.\n");
+    printf("  -h               Show this message.\n");
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    const char *datadir = NETHACKDIR, *scriptfile = NULL, *rolename = NULL;
+    const char *outfile = NULL, *keepdir = NULL;
+    char *gameopts[MAX_GAME_OPTIONS], *value;
+    char workdir[] = "/tmp/nethack_bench.XXXXXX", datapath[4096];
+    char *paths[PREFIX_COUNT];
+    struct game_result *results;
+    union nh_optvalue optval;
+    unsigned int seed = 1;
+    int opt, i, ngames = 1, max_actions = DEFAULT_ACTIONS, json = FALSE;
+    int ngameopts = 0;
+    int ok = TRUE;
+    FILE *out = stdout;
+
+    while ((opt = getopt(argc, argv, "a:d:f:hJk:n:O:o:r:s:uy:")) != -1) {
+        switch (opt) {
+        case 'a':
+            max_actions = atoi(optarg);
+            break;
+        case 'd':
+            datadir = optarg;
+            break;
+        case 'f':
+            scriptfile = optarg;
+            break;
+        case 'J':
+            json = TRUE;
+            break;
+        case 'k':
+            keepdir = optarg;
+            break;
+        case 'n':
+            ngames = atoi(optarg);
+            break;
+        case 'O':
+            if (ngameopts == MAX_GAME_OPTIONS || !strchr(optarg, '=')) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            gameopts[ngameopts++] = optarg;
+            break;
+        case 'o':
+            outfile = optarg;
+            break;
+        case 'r':
+            rolename = optarg;
+            break;
+        case 's':
+            seed = strtoul(optarg, NULL, 10);
+            break;
+        case 'u':
+            walk_up = TRUE;
+            break;
+        case 'y':
+            yn_answer = *optarg;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt != 'h';
+        }
+    }
+    if (ngames < 1 || max_actions < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (scriptfile && !load_script(scriptfile))
+        return 1;
+
+    /* the game writes scores, bones, dumps and lock files; keep all of that
+       in a scratch directory so runs can't influence each other */
+    if (!mkdtemp(workdir)) {
+        fprintf(stderr, "Error: could not create a work directory: %s\n",
+                strerror(errno));
+        return 1;
+    }
+    snprintf(datapath, sizeof (datapath), "%s/", datadir);
+    for (i = 0; i < PREFIX_COUNT; i++) {
+        paths[i] = malloc(strlen(workdir) + 2);
+        sprintf(paths[i], "%s/", workdir);
+    }
+    free(paths[DATAPREFIX]);
+    paths[DATAPREFIX] = datapath;
+
+    nh_lib_init(&bench_windowprocs, paths);
+    optval.b = FALSE;
+    nh_set_option("bones", optval, FALSE);
+    for (i = 0; i < ngameopts; i++) {
+        value = strchr(gameopts[i], '=');
+        *value++ = '\0';
+        optval.s = value;
+        if (!nh_set_option(gameopts[i], optval, TRUE)) {
+            fprintf(stderr, "Error: could not set option %s to \"%s\"\n",
+                    gameopts[i], value);
+            ok = FALSE;
+        }
+    }
+
+    for (i = 0; i < nh_get_drawing_info()->num_bgelements; i++)
+        if (!strcmp(nh_get_drawing_info()->bgelements[i].symname, "dnstair"))
+            dnstair_id = i;
+        else if (!strcmp(nh_get_drawing_info()->bgelements[i].symname,
+                         "upstair"))
+            upstair_id = i;
+
+    nh_bench_enable(TRUE);
+    results = calloc(ngames, sizeof (struct game_result));
+    for (i = 0; i < ngames && ok; i++)
+        ok = run_game(seed + i, rolename, max_actions, workdir, keepdir,
+                      &results[i]);
+    nh_bench_enable(FALSE);
+    nh_bench_fix_seed(FALSE, 0, 0);
+
+    nh_lib_exit();
+    nftw(workdir, remove_entry, 8, FTW_DEPTH | FTW_PHYS);
+
+    if (ok) {
+        if (outfile && !(out = fopen(outfile, "w"))) {
+            fprintf(stderr, "Error: could not open %s: %s\n", outfile,
+                    strerror(errno));
+            ok = FALSE;
+        } else {
+            if (json)
+                print_json(out, results, ngames, scriptfile ? "script" : "walk",
+                           max_actions);
+            else
+                print_text(out, results, ngames);
+            if (out != stdout)
+                fclose(out);
+        }
+    }
+
+    for (i = 0; i < PREFIX_COUNT; i++)
+        if (i != DATAPREFIX)
+            free(paths[i]);
+    free(results);
+    free(script);
+
+    return !ok;
+}
@@ -75,6 +75,9 @@ struct settings {
     char nodaemon;
     char disable_ipv4;
     char disable_ipv6;
+    char nocompress_ipv4;       /* don't offer compression to clients that */
+    char nocompress_ipv6;       /* connected to this listener */
+    char nocompress_unix;
     char *dbhost, *dbname, *dbport, *dbuser, *dbpass;
 };
 
@@ -119,12 +122,14 @@ extern struct nh_player_info player_info;
 extern int auth_user(char *authbuf, const char *peername, int *is_reg,
                      int *reconnect_id);
 extern void auth_send_result(int sockfd, enum authresult, int is_reg,
-                             int connid);
+                             int connid, int can_compress);
 
 /* clientmain.c */
+extern void init_game_library(void);
 extern void client_main(int userid, int infd, int outfd);
 extern void exit_client(const char *err);
 extern void client_msg(const char *key, json_t * value);
+extern void set_compression(int enable);
 extern json_t *read_input(void);
 
 /* config.c */
@@ -183,6 +188,13 @@ extern int remove_unix_socket(void);
 extern int runserver(void);
 
 /* winprocs.c */
+/* optional protocol extensions the client has asked for */
+# define CLIENT_FEATURE_PACKED_SCREEN   0x01
+# define CLIENT_FEATURE_DEFLATE         0x02
+# define CLIENT_FEATURE_UPDATE_INVENTORY 0x04
+
+extern int client_request_count;
+extern void set_client_features(unsigned int features);
 extern json_t *get_display_data(void);
 extern void reset_cached_diplaydata(void);
 extern void srv_display_buffer(const char *buf, nh_bool trymove);
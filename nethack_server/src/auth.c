@@ -119,7 +119,8 @@ err:
 
 
 void
-auth_send_result(int sockfd, enum authresult result, int is_reg, int connid)
+auth_send_result(int sockfd, enum authresult result, int is_reg, int connid,
+                 int can_compress)
 {
     int ret, written, len;
     json_t *jval;
@@ -130,9 +131,19 @@ auth_send_result(int sockfd, enum authresult result, int is_reg, int connid)
     if (is_reg)
         key = "register";
 
+    /* "features" lists the optional protocol extensions this server supports;
+       clients only use an extension if it is listed here */
     jval =
-        json_pack("{s:{si,si,s:[i,i,i]}}", key, "return", result, "connection",
-                  connid, "version", VERSION_MAJOR, VERSION_MINOR, PATCHLEVEL);
+        json_pack("{s:{si,si,s:[i,i,i],s:[s,s,s]}}", key, "return", result,
+                  "connection", connid, "version", VERSION_MAJOR, VERSION_MINOR,
+                  PATCHLEVEL, "features", "game_command_batch",
+                  "update_screen_packed", "update_inventory");
+    /* compression is configured per listener: it's a waste of time for
+       clients on the same machine */
+    if (can_compress)
+        json_array_append_new(json_object_get(json_object_get(jval, key),
+                                              "features"),
+                              json_string("deflate"));
     jstr = json_dumps(jval, JSON_COMPACT);
     len = strlen(jstr);
     written = 0;
@@ -13,6 +13,7 @@ static void ccmd_start_game(json_t * params);
 static void ccmd_restore_game(json_t * params);
 static void ccmd_exit_game(json_t * params);
 static void ccmd_game_command(json_t * params);
+static void ccmd_game_command_batch(json_t * params);
 static void ccmd_view_start(json_t * params);
 static void ccmd_view_step(json_t * params);
 static void ccmd_view_finish(json_t * params);
@@ -29,6 +30,7 @@ static void ccmd_get_pl_prompt(json_t * params);
 static void ccmd_get_root_pl_prompt(json_t * params);
 static void ccmd_set_email(json_t * params);
 static void ccmd_set_password(json_t * params);
+static void ccmd_set_features(json_t * params);
 
 const struct client_command clientcmd[] = {
     {"shutdown", ccmd_shutdown, 0},
@@ -37,6 +39,7 @@ const struct client_command clientcmd[] = {
     {"restore_game", ccmd_restore_game, 0},
     {"exit_game", ccmd_exit_game, 0},
     {"game_command", ccmd_game_command, 0},
+    {"game_command_batch", ccmd_game_command_batch, 0},
     {"view_start", ccmd_view_start, 0},
     {"view_step", ccmd_view_step, 0},
     {"view_finish", ccmd_view_finish, 0},
@@ -57,6 +60,7 @@ const struct client_command clientcmd[] = {
 
     {"set_email", ccmd_set_email, 1},
     {"set_password", ccmd_set_password, 1},
+    {"set_features", ccmd_set_features, 1},
 
     {NULL, NULL}
 };
@@ -205,35 +209,33 @@ ccmd_exit_game(json_t * params)
 
 
 static void
-ccmd_game_command(json_t * params)
+unpack_game_command(json_t * params, const char **cmd, int *count,
+                    struct nh_cmd_arg *arg)
 {
     json_t *jarg;
-    int count, result, gid;
-    const char *cmd;
-    struct nh_cmd_arg arg;
 
     if (json_unpack
-        (params, "{ss,so,si*}", "command", &cmd, "arg", &jarg, "count",
-         &count) == -1)
+        (params, "{ss,so,si*}", "command", cmd, "arg", &jarg, "count",
+         count) == -1)
         exit_client("Bad set of parameters for game_command");
 
-    if (json_unpack(jarg, "{si*}", "argtype", &arg.argtype) == -1)
+    if (json_unpack(jarg, "{si*}", "argtype", &arg->argtype) == -1)
         exit_client("Bad parameter arg in game_command");
 
-    switch (arg.argtype) {
+    switch (arg->argtype) {
     case CMD_ARG_DIR:
-        if (json_unpack(jarg, "{si*}", "d", &arg.d) == -1)
+        if (json_unpack(jarg, "{si*}", "d", &arg->d) == -1)
             exit_client("Bad direction arg in game_command");
         break;
 
     case CMD_ARG_POS:
-        if (json_unpack(jarg, "{si,si*}", "x", &arg.pos.x, "y", &arg.pos.y) ==
-            -1)
+        if (json_unpack(jarg, "{si,si*}", "x", &arg->pos.x, "y", &arg->pos.y)
+            == -1)
             exit_client("Bad position arg in game_command");
         break;
 
     case CMD_ARG_OBJ:
-        if (json_unpack(jarg, "{si*}", "invlet", &arg.invlet) == -1)
+        if (json_unpack(jarg, "{si*}", "invlet", &arg->invlet) == -1)
             exit_client("Bad invlet arg in game_command");
         break;
 
@@ -242,12 +244,15 @@ ccmd_game_command(json_t * params)
         break;
     }
 
-    if (cmd[0] == '\0')
-        cmd = NULL;
+    if ((*cmd)[0] == '\0')
+        *cmd = NULL;
+}
 
-    result = nh_command(cmd, count, &arg);
 
-    gid = gameid;
+/* close the game file once nh_command has returned a final status */
+static void
+close_finished_game(int result)
+{
     if (result >= GAME_OVER) {
         close(gamefd);
         log_msg("Game %d (by %s) closed: game %s.", gameid, user_info.username,
@@ -255,8 +260,13 @@ ccmd_game_command(json_t * params)
         gamefd = -1;
         gameid = 0;
     }
+}
 
-    client_msg("game_command", json_pack("{si}", "return", result));
+
+/* bookkeeping after the response to a game command has been sent */
+static void
+game_command_done(int result, int gid)
+{
     db_update_game(gameid, player_info.moves, player_info.z,
                    player_info.level_desc);
 
@@ -283,6 +293,66 @@ ccmd_game_command(json_t * params)
 }
 
 
+static void
+ccmd_game_command(json_t * params)
+{
+    int count, result, gid;
+    const char *cmd;
+    struct nh_cmd_arg arg;
+
+    unpack_game_command(params, &cmd, &count, &arg);
+
+    result = nh_command(cmd, count, &arg);
+
+    gid = gameid;
+    close_finished_game(result);
+
+    client_msg("game_command", json_pack("{si}", "return", result));
+    game_command_done(result, gid);
+}
+
+
+/* Run several game commands for a single request, so that a client can send
+ * keystrokes it knows ahead of time (a count-prefixed movement burst, a macro)
+ * without waiting a round trip for each one.  The commands are run in order
+ * until one of them doesn't leave the game ready for the next command, or
+ * until the game needs to ask the client something: anything sent after the
+ * prompt was typed without knowing about it, so the rest is dropped.  The
+ * display updates of all the commands go out with the single response, which
+ * also says how many commands were run. */
+static void
+ccmd_game_command_batch(json_t * params)
+{
+    json_t *jcmds;
+    int count, result, gid, i, ncmds, requests;
+    const char *cmd;
+    struct nh_cmd_arg arg;
+
+    if (json_unpack(params, "{so*}", "commands", &jcmds) == -1 ||
+        !json_is_array(jcmds) || json_array_size(jcmds) == 0)
+        exit_client("Bad set of parameters for game_command_batch");
+    ncmds = json_array_size(jcmds);
+
+    requests = client_request_count;
+    result = READY_FOR_INPUT;
+    for (i = 0; i < ncmds; i++) {
+        unpack_game_command(json_array_get(jcmds, i), &cmd, &count, &arg);
+        result = nh_command(cmd, count, &arg);
+        if (result != READY_FOR_INPUT || client_request_count != requests) {
+            i++;
+            break;
+        }
+    }
+
+    gid = gameid;
+    close_finished_game(result);
+
+    client_msg("game_command_batch",
+               json_pack("{si,si}", "return", result, "done", i));
+    game_command_done(result, gid);
+}
+
+
 static void
 ccmd_view_start(json_t * params)
 {
@@ -933,4 +1003,36 @@ ccmd_set_password(json_t * params)
     client_msg("set_password", json_pack("{si}", "return", ret));
 }
 
+
+/* set_features: the client tells us which of the protocol extensions listed
+ * in the auth response it wants to use */
+static void
+ccmd_set_features(json_t * params)
+{
+    json_t *jarr;
+    const char *feature;
+    unsigned int features = 0;
+    size_t i;
+
+    if (json_unpack(params, "{so*}", "features", &jarr) == -1 ||
+        !json_is_array(jarr))
+        exit_client("Bad set of parameters for set_features");
+
+    for (i = 0; i < json_array_size(jarr); i++) {
+        feature = json_string_value(json_array_get(jarr, i));
+        if (feature && !strcmp(feature, "update_screen_packed"))
+            features |= CLIENT_FEATURE_PACKED_SCREEN;
+        else if (feature && !strcmp(feature, "deflate"))
+            features |= CLIENT_FEATURE_DEFLATE;
+        else if (feature && !strcmp(feature, "update_inventory"))
+            features |= CLIENT_FEATURE_UPDATE_INVENTORY;
+    }
+    set_client_features(features);
+
+    /* the response itself is still uncompressed; everything after it is */
+    set_compression(FALSE);
+    client_msg("set_features", json_pack("{si}", "return", TRUE));
+    set_compression(features & CLIENT_FEATURE_DEFLATE);
+}
+
 /* clientcmd.c */
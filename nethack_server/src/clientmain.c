@@ -8,6 +8,7 @@
 #include "nhserver.h"
 #include <poll.h>
 #include <ctype.h>
+#include <zlib.h>
 
 #define COMMBUF_SIZE (1024 * 1024)
 
@@ -33,6 +34,13 @@ long gameid;    /* id in the database */
 struct user_info user_info;
 int can_send_msg;
 
+/* Output compression: once the client has asked for it, everything sent to
+ * it goes through a single deflate stream that lasts for the whole connection.
+ * Each message ends with a sync flush, so the client can decode it completely
+ * without waiting for more data. */
+static z_stream zout;
+static int compress_output, zout_initialized;
+
 
 static char **
 init_game_paths(void)
@@ -83,10 +91,66 @@ init_game_paths(void)
 }
 
 
+static void
+write_to_client(const char *data, int len)
+{
+    int ret, pos;
+
+    pos = 0;
+    do {
+        ret = write(outfd, &data[pos], len - pos);
+        if (ret == -1 && (errno == EINTR || errno == EAGAIN))
+            continue;
+        else if (ret == -1 || ret == 0) {       /* bad news */
+            /* since we just found we can't write output to the pipe, prevent
+               any more tries */
+            close(infd);
+            close(outfd);
+            infd = outfd = -1;
+            exit_client(NULL);  /* Goodbye. */
+        }
+        pos += ret;
+    } while (pos < len);
+}
+
+
+static void
+write_compressed(char *data, int len)
+{
+    unsigned char zbuf[16384];
+
+    zout.next_in = (unsigned char *)data;
+    zout.avail_in = len;
+    do {
+        zout.next_out = zbuf;
+        zout.avail_out = sizeof (zbuf);
+        deflate(&zout, Z_SYNC_FLUSH);
+        write_to_client((char *)zbuf, sizeof (zbuf) - zout.avail_out);
+    } while (zout.avail_out == 0);
+}
+
+
+/* Compression starts with a fresh stream each time it is switched on: the
+ * client only switches on decompression after the response to set_features,
+ * and it may be a new client after a reconnect. */
+void
+set_compression(int enable)
+{
+    if (enable) {
+        if (!zout_initialized)
+            zout_initialized = deflateInit(&zout, Z_DEFAULT_COMPRESSION) ==
+                Z_OK;
+        else
+            deflateReset(&zout);
+        enable = zout_initialized;
+    }
+    compress_output = enable;
+}
+
+
 void
 client_msg(const char *key, json_t * value)
 {
-    int len, ret, pos;
     char *jsonstr;
     json_t *jval, *display_data;
 
@@ -105,22 +169,10 @@ client_msg(const char *key, json_t * value)
     json_decref(jval);
 
     if (can_send_msg) {
-        len = strlen(jsonstr);
-        pos = 0;
-        do {
-            ret = write(outfd, &jsonstr[pos], len - pos);
-            if (ret == -1 && (errno == EINTR || errno == EAGAIN))
-                continue;
-            else if (ret == -1 || ret == 0) {   /* bad news */
-                /* since we just found we can't write output to the pipe,
-                   prevent any more tries */
-                close(infd);
-                close(outfd);
-                infd = outfd = -1;
-                exit_client(NULL);      /* Goodbye. */
-            }
-            pos += ret;
-        } while (pos < len);
+        if (compress_output)
+            write_compressed(jsonstr, strlen(jsonstr));
+        else
+            write_to_client(jsonstr, strlen(jsonstr));
     }
     /* this message is sent; don't send another */
     can_send_msg = FALSE;
@@ -206,6 +258,10 @@ read_input(void)
             datalen = ret - 1;
             /* also reset the cached display data to make sure all display
                state is re-sent */
+            /* the new connection starts without any protocol extensions; the
+               client will ask for them again */
+            set_client_features(0);
+            set_compression(FALSE);
             continue;
         }
 
@@ -275,6 +331,26 @@ client_main_loop(void)
 }
 
 
+/*
+ * Set up libnethack for this process.  The server calls this once before it
+ * starts accepting connections, so that the data files libnethack loads are
+ * read only once and the copy is shared by all the forked client processes;
+ * each client process then calls it again to start from a clean state.
+ */
+void
+init_game_library(void)
+{
+    char **gamepaths;
+    int i;
+
+    gamepaths = init_game_paths();
+    nh_lib_init(&server_windowprocs, gamepaths);
+    for (i = 0; i < PREFIX_COUNT; i++)
+        free(gamepaths[i]);
+    free(gamepaths);
+}
+
+
 /*
  * This is the start of the client handling code.
  * The server process has accepted a connection and authenticated it. Data from
@@ -286,9 +362,6 @@ client_main_loop(void)
 void
 client_main(int userid, int _infd, int _outfd)
 {
-    char **gamepaths;
-    int i;
-
     infd = _infd;
     outfd = _outfd;
     gamefd = -1;
@@ -299,11 +372,7 @@ client_main(int userid, int _infd, int _outfd)
         exit_client("database error");
     }
 
-    gamepaths = init_game_paths();
-    nh_lib_init(&server_windowprocs, gamepaths);
-    for (i = 0; i < PREFIX_COUNT; i++)
-        free(gamepaths[i]);
-    free(gamepaths);
+    init_game_library();
 
     db_restore_options(userid);
 
@@ -153,6 +153,20 @@ parse_config_line(char *line)
         }
     }
 
+    else if (!strcmp(line, "disable_compression")) {
+        if (!strcmp(val, "v4"))
+            settings.nocompress_ipv4 = TRUE;
+        else if (!strcmp(val, "v6"))
+            settings.nocompress_ipv6 = TRUE;
+        else if (!strcmp(val, "unix"))
+            settings.nocompress_unix = TRUE;
+        else {
+            fprintf(stderr,
+                    "Error: the value for disable_compression is v4, v6 or unix, not %s.\n",
+                    val);
+        }
+    }
+
     else if (!strcmp(line, "unixsocket")) {
         if (strlen(val) > SUN_PATH_MAX - 1) {
             fprintf(stderr, "Error: The unix socket filename is too long.\n");
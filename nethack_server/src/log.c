@@ -113,6 +113,13 @@ report_startup(void)
     else if (settings.disable_ipv6)
         log_msg("  disable_family = v6");
 
+    if (settings.nocompress_ipv4)
+        log_msg("  disable_compression = v4");
+    if (settings.nocompress_ipv6)
+        log_msg("  disable_compression = v6");
+    if (settings.nocompress_unix)
+        log_msg("  disable_compression = unix");
+
     log_msg("  ipv4addr = %s", addr2str(&settings.bind_addr_4));
     log_msg("  ipv6addr = %s", addr2str(&settings.bind_addr_6));
     log_msg("  unixsocket = %s", addr2str(&settings.bind_addr_unix));
@@ -404,6 +404,30 @@ server_socket_event(int server_fd, int epfd)
 }
 
 
+/* may the connection use compression? It depends on the listener that
+   accepted it */
+static int
+can_compress(int fd)
+{
+    struct sockaddr_storage addr;
+    socklen_t addrlen = sizeof (addr);
+
+    if (getsockname(fd, (struct sockaddr *)&addr, &addrlen) == -1)
+        return FALSE;
+
+    switch (addr.ss_family) {
+    case AF_INET:
+        return !settings.nocompress_ipv4;
+    case AF_INET6:
+        return !settings.nocompress_ipv6;
+    case AF_UNIX:
+        return !settings.nocompress_unix;
+    default:
+        return FALSE;
+    }
+}
+
+
 static void
 handle_new_connection(int newfd, int epfd)
 {
@@ -412,7 +436,7 @@ handle_new_connection(int newfd, int epfd)
     struct sockaddr_storage addr;
     socklen_t addrlen = sizeof (addr);
     char authbuf[AUTHBUFSIZE];
-    int pos, is_reg, reconnect_id, authlen, userid;
+    int pos, is_reg, reconnect_id, authlen, userid, compress;
     static int connection_id = 1;
 
     if (fd_to_client_max > newfd &&
@@ -457,11 +481,14 @@ handle_new_connection(int newfd, int epfd)
      * ready to authenticate the user here
      */
     userid = auth_user(authbuf, addr2str(&addr), &is_reg, &reconnect_id);
+    compress = can_compress(newfd);
     if (userid <= 0) {
         if (!userid)
-            auth_send_result(newfd, AUTH_FAILED_UNKNOWN_USER, is_reg, 0);
+            auth_send_result(newfd, AUTH_FAILED_UNKNOWN_USER, is_reg, 0,
+                             compress);
         else
-            auth_send_result(newfd, AUTH_FAILED_BAD_PASSWORD, is_reg, 0);
+            auth_send_result(newfd, AUTH_FAILED_BAD_PASSWORD, is_reg, 0,
+                             compress);
         log_msg("authentication failed for %s", addr2str(&addr));
         close(newfd);
         return;
@@ -495,7 +522,8 @@ handle_new_connection(int newfd, int epfd)
 
     if (client) {
         /* there is a running, disconnected game process for this user */
-        auth_send_result(newfd, AUTH_SUCCESS_RECONNECT, is_reg, client->connid);
+        auth_send_result(newfd, AUTH_SUCCESS_RECONNECT, is_reg, client->connid,
+                         compress);
         client->sock = newfd;
         map_fd_to_client(client->sock, client);
         client->state = CLIENT_CONNECTED;
@@ -516,7 +544,8 @@ handle_new_connection(int newfd, int epfd)
         client->userid = userid;
         /* there is no process yet */
         if (fork_client(client, epfd))
-            auth_send_result(newfd, AUTH_SUCCESS_NEW, is_reg, client->connid);
+            auth_send_result(newfd, AUTH_SUCCESS_NEW, is_reg, client->connid,
+                             compress);
         /* else: client communication is shutdown if fork_client errors out */
     }
 
@@ -890,6 +919,8 @@ runserver(void)
     if (!setup_server_sockets(&ipv4fd, &ipv6fd, &unixfd, epfd))
         return FALSE;
 
+    init_game_library();
+
     /* 
      * server event loop
      */
@@ -28,6 +28,8 @@ static int srv_display_objects(struct nh_objitem *items, int icount,
                                struct nh_objresult *pick_list);
 static nh_bool srv_list_items(struct nh_objitem *items, int icount,
                               nh_bool invent);
+static void srv_update_inventory(struct nh_objitem *changed, int nchanged,
+                                 int *order, int icount);
 static char srv_query_key(const char *query, int *count);
 static int srv_getpos(int *x, int *y, nh_bool force, const char *goal);
 static enum nh_direction srv_getdir(const char *query, nh_bool restricted);
@@ -56,8 +58,12 @@ static nh_bool srv_alt_list_items(struct nh_objitem *items, int icount,
 struct nh_player_info player_info;
 static struct nh_dbuf_entry prev_dbuf[ROWNO][COLNO];
 static int prev_invent_icount, prev_floor_icount;
-static struct nh_objitem *prev_invent;
+static struct nh_objitem *prev_invent;  /* as the client has it */
+static int game_invent_icount;
+static struct nh_objitem *game_invent;  /* as the game last reported it */
+static nh_bool game_invent_changed;
 static const struct nh_dbuf_entry zero_dbuf;    /* an entry of all zeroes */
+static unsigned int client_features;
 static json_t *display_data, *jinvent_items, *jfloor_items;
 static int altproc;
 
@@ -80,6 +86,7 @@ struct nh_window_procs server_windowprocs = {
     srv_level_changed,
     srv_outrip,
     srv_print_message_nonblocking,
+    srv_update_inventory,
 };
 
 
@@ -107,6 +114,10 @@ struct nh_window_procs server_alt_windowprocs = {
 
 /*---------------------------------------------------------------------------*/
 
+/* incremented whenever the game has to ask the client something; used to
+   stop a batch of game commands at the first prompt */
+int client_request_count;
+
 static json_t *
 client_request(const char *funcname, json_t * request_msg)
 {
@@ -115,6 +126,7 @@ client_request(const char *funcname, json_t * request_msg)
     const char *key;
     int i;
 
+    client_request_count++;
     client_msg(funcname, request_msg);
 
     /* client response */
@@ -178,6 +190,87 @@ add_display_data(const char *key, json_t * data)
 }
 
 
+static json_t *json_objitem(struct nh_objitem *oi);
+
+/* Find the position of each key (see NH_OBJITEM_KEY) in items; pos must have
+   space for 512 entries.  Returns FALSE if a key is used twice. */
+static nh_bool
+invent_key_positions(const struct nh_objitem *items, int icount, short *pos)
+{
+    int i, key;
+
+    for (i = 0; i < 512; i++)
+        pos[i] = -1;
+    for (i = 0; i < icount; i++) {
+        key = NH_OBJITEM_KEY(&items[i]) + 256;
+        if (pos[key] != -1)
+            return FALSE;
+        pos[key] = i;
+    }
+    return TRUE;
+}
+
+
+/* Bring the client's copy of the inventory up to date with the game's.  If the
+   client asked for the "update_inventory" feature, only the entries that
+   changed since it last heard about the inventory are sent, together with the
+   order of all entries; the first list after a reset is sent in full.  Other
+   clients always get the full list. */
+static void
+flush_inventory(void)
+{
+    int i, key, nchanged = 0;
+    short prevpos[512], curpos[512];
+    nh_bool same_order = (game_invent_icount == prev_invent_icount);
+    json_t *jarr, *jorder;
+
+    if (!game_invent_changed)
+        return;
+    game_invent_changed = FALSE;
+
+    if (!(client_features & CLIENT_FEATURE_UPDATE_INVENTORY) || !prev_invent ||
+        !invent_key_positions(prev_invent, prev_invent_icount, prevpos) ||
+        !invent_key_positions(game_invent, game_invent_icount, curpos)) {
+        jarr = json_array();
+        for (i = 0; i < game_invent_icount; i++)
+            json_array_append_new(jarr, json_objitem(&game_invent[i]));
+        add_display_data("list_items",
+                         json_pack("{so,si,si}", "items", jarr, "icount",
+                                   game_invent_icount, "invent", 1));
+    } else {
+        jarr = json_array();
+        jorder = json_array();
+        for (i = 0; i < game_invent_icount; i++) {
+            key = NH_OBJITEM_KEY(&game_invent[i]);
+            json_array_append_new(jorder, json_integer(key));
+            if (prevpos[key + 256] != i)
+                same_order = FALSE;
+            if (prevpos[key + 256] < 0 ||
+                memcmp(&game_invent[i], &prev_invent[prevpos[key + 256]],
+                       sizeof (struct nh_objitem))) {
+                json_array_append_new(jarr, json_objitem(&game_invent[i]));
+                nchanged++;
+            }
+        }
+
+        if (nchanged || !same_order)
+            add_display_data("update_inventory",
+                             json_pack("{so,so}", "items", jarr, "order",
+                                       jorder));
+        else {
+            json_decref(jarr);
+            json_decref(jorder);
+        }
+    }
+
+    free(prev_invent);
+    prev_invent_icount = game_invent_icount;
+    prev_invent = malloc(sizeof (struct nh_objitem) * game_invent_icount);
+    memcpy(prev_invent, game_invent,
+           sizeof (struct nh_objitem) * game_invent_icount);
+}
+
+
 json_t *
 get_display_data(void)
 {
@@ -191,6 +284,7 @@ get_display_data(void)
         add_display_data("list_items", jinvent_items);
         jinvent_items = NULL;
     }
+    flush_inventory();
     dd = display_data;
     display_data = NULL;
     return dd;
@@ -331,12 +425,164 @@ srv_print_message_nonblocking(int turn, const char *msg)
     add_display_data("print_message_nonblocking", jobj);
 }
 
+/*
+ * Packed screen updates:
+ *
+ * Most of the map consists of a few distinct dbuf entries (floor, walls,
+ * unlit areas, blank), so clients that ask for it get a palette of entries
+ * instead of one array per cell.  The palette lives for the whole session:
+ * each update_screen_packed message only carries the entries that are new,
+ * along with the palette index at which they start ("base"); a base of 0
+ * tells the client to start a new palette.  The cells follow in row-major
+ * order as runs, each encoded as a single integer
+ *     length * PACKED_RUN_MULT + symbol
+ * where symbol 0 means "unchanged" and symbol n means palette entry n-1.
+ * A palette entry is [effect,bg,trap,obj,obj_mn,mon,monflags,branding,flags]
+ * with invis and visible packed into the bits of flags.
+ */
+#define PACKED_RUN_MULT 65536
+#define PALETTE_MAX     4096    /* must stay below PACKED_RUN_MULT */
+#define PALETTE_HASHSIZE 8192   /* power of 2, at least 2 * PALETTE_MAX */
+
+static struct nh_dbuf_entry palette[PALETTE_MAX];
+static int palette_size, palette_sent;
+static short palette_hash[PALETTE_HASHSIZE];    /* index + 1, 0 if unused */
+
+
+static void
+reset_screen_palette(void)
+{
+    palette_size = palette_sent = 0;
+    memset(palette_hash, 0, sizeof (palette_hash));
+}
+
+
+void
+set_client_features(unsigned int features)
+{
+    client_features = features;
+    /* the client may be new, so it can't have any of the palette or know
+       the inventory */
+    reset_screen_palette();
+    free(prev_invent);
+    prev_invent = NULL;
+    prev_invent_icount = 0;
+    game_invent_changed = (game_invent != NULL);
+}
+
+
+static unsigned int
+hash_dbuf_entry(const struct nh_dbuf_entry *dbe)
+{
+    unsigned int h = dbe->effect;
+
+    h = h * 31 + dbe->bg;
+    h = h * 31 + dbe->trap;
+    h = h * 31 + dbe->obj;
+    h = h * 31 + dbe->obj_mn;
+    h = h * 31 + dbe->mon;
+    h = h * 31 + dbe->monflags;
+    h = h * 31 + dbe->branding;
+    h = h * 4 + (dbe->invis ? 2 : 0) + (dbe->visible ? 1 : 0);
+    return h ^ (h >> 13);
+}
+
+
+/* returns the palette index of the entry, adding it if necessary; -1 if the
+   palette is full */
+static int
+palette_index(const struct nh_dbuf_entry *dbe)
+{
+    unsigned int h = hash_dbuf_entry(dbe) & (PALETTE_HASHSIZE - 1);
+
+    while (palette_hash[h]) {
+        if (!memcmp(&palette[palette_hash[h] - 1], dbe, sizeof (*dbe)))
+            return palette_hash[h] - 1;
+        h = (h + 1) & (PALETTE_HASHSIZE - 1);
+    }
+
+    if (palette_size == PALETTE_MAX)
+        return -1;
+    palette[palette_size] = *dbe;
+    palette_hash[h] = ++palette_size;
+    return palette_size - 1;
+}
+
+
+static void
+update_screen_packed(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
+{
+    static int symbols[ROWNO * COLNO];
+    int i, x, y, n, sym, runlen, changed;
+    const struct nh_dbuf_entry *dbe;
+    json_t *jmsg, *jpalette, *jruns;
+
+    /* map every cell to its symbol first; if the palette overflows, start a
+       new one and map the whole screen again */
+    for (i = 0; i < 2; i++) {
+        changed = 0;
+        for (n = y = 0; y < ROWNO; y++)
+            for (x = 0; x < COLNO; x++, n++) {
+                if (!memcmp(&dbuf[y][x], &prev_dbuf[y][x], sizeof (dbuf[y][x])))
+                    symbols[n] = 0;
+                else if ((sym = palette_index(&dbuf[y][x])) == -1)
+                    break;
+                else {
+                    symbols[n] = sym + 1;
+                    changed++;
+                }
+            }
+        if (n == ROWNO * COLNO)
+            break;
+        reset_screen_palette();
+    }
+
+    if (!changed)
+        return; /* no point in sending out a message that nothing changed */
+
+    jpalette = json_array();
+    for (i = palette_sent; i < palette_size; i++) {
+        dbe = &palette[i];
+        json_array_append_new(jpalette,
+                              json_pack("[i,i,i,i,i,i,i,i,i]", dbe->effect,
+                                        dbe->bg, dbe->trap, dbe->obj,
+                                        dbe->obj_mn, dbe->mon, dbe->monflags,
+                                        dbe->branding,
+                                        (dbe->invis ? 1 : 0) |
+                                        (dbe->visible ? 2 : 0)));
+    }
+
+    jruns = json_array();
+    for (n = 0; n < ROWNO * COLNO; n += runlen) {
+        for (runlen = 1; n + runlen < ROWNO * COLNO &&
+             symbols[n + runlen] == symbols[n]; runlen++)
+            ;
+        json_array_append_new(jruns,
+                              json_integer(runlen * PACKED_RUN_MULT +
+                                           symbols[n]));
+    }
+
+    jmsg = json_pack("{si,si,si,so,so}", "ux", ux, "uy", uy, "base",
+                     palette_sent, "palette", jpalette, "runs", jruns);
+    palette_sent = palette_size;
+    add_display_data("update_screen_packed", jmsg);
+
+    for (i = 0; i < ROWNO; i++)
+        memcpy(&prev_dbuf[i], &dbuf[i], sizeof (dbuf[i]));
+}
+
+
 static void
 srv_update_screen(struct nh_dbuf_entry dbuf[ROWNO][COLNO], int ux, int uy)
 {
     int i, x, y, samedbe, samecols, zerodbe, zerocols, is_same, is_zero;
     json_t *jmsg, *jdbuf, *dbufcol, *dbufent;
 
+    if (client_features & CLIENT_FEATURE_PACKED_SCREEN) {
+        update_screen_packed(dbuf, ux, uy);
+        return;
+    }
+
     samecols = 0;
     zerocols = 0;
     jdbuf = json_array();
@@ -539,23 +785,41 @@ srv_display_objects(struct nh_objitem *items, int icount, const char *title,
 }
 
 
+static void
+set_game_invent(struct nh_objitem *items, int icount)
+{
+    struct nh_objitem *newinv = malloc(sizeof (struct nh_objitem) * icount);
+
+    memcpy(newinv, items, sizeof (struct nh_objitem) * icount);
+    free(game_invent);
+    game_invent = newinv;
+    game_invent_icount = icount;
+    game_invent_changed = TRUE;
+}
+
+
 static nh_bool
 srv_list_items(struct nh_objitem *items, int icount, nh_bool invent)
 {
     int i;
     json_t *jobj, *jarr;
 
-    if (invent && prev_invent && icount == prev_invent_icount &&
-        !memcmp(items, prev_invent, sizeof (struct nh_objitem) * icount))
+    /* The inventory is sent when the display data is flushed, as changes
+       relative to what the client already has. */
+    if (invent && !altproc) {
+        set_game_invent(items, icount);
         return TRUE;
+    }
+
     if (!invent && icount == 0 && prev_floor_icount == 0)
         return TRUE;
 
     if (invent) {
-        prev_invent_icount = icount;
+        /* a replay inventory replaces what the client knows */
         free(prev_invent);
-        prev_invent = malloc(sizeof (struct nh_objitem) * icount);
-        memcpy(prev_invent, items, sizeof (struct nh_objitem) * icount);
+        prev_invent = NULL;
+        prev_invent_icount = 0;
+        game_invent_changed = (game_invent != NULL);
     } else
         prev_floor_icount = icount;
 
@@ -589,6 +853,44 @@ srv_list_items(struct nh_objitem *items, int icount, nh_bool invent)
 }
 
 
+/* The game only tells us about the entries that changed; rebuild the full
+   inventory from the previous one so that the client can be brought up to
+   date however many updates it missed. */
+static void
+srv_update_inventory(struct nh_objitem *changed, int nchanged, int *order,
+                     int icount)
+{
+    int i, j;
+    short oldpos[512], newpos[512];
+    struct nh_objitem *items;
+
+    if (!game_invent ||
+        !invent_key_positions(game_invent, game_invent_icount, oldpos))
+        exit_client("Inventory update without a previous inventory");
+
+    for (i = 0; i < 512; i++)
+        newpos[i] = -1;
+    for (i = 0; i < nchanged; i++)
+        newpos[NH_OBJITEM_KEY(&changed[i]) + 256] = i;
+
+    items = malloc(sizeof (struct nh_objitem) * icount);
+    for (i = 0; i < icount; i++) {
+        j = order[i] + 256;
+        if (newpos[j] >= 0)
+            items[i] = changed[newpos[j]];
+        else if (oldpos[j] >= 0)
+            items[i] = game_invent[oldpos[j]];
+        else
+            exit_client("Inventory update for an unknown item");
+    }
+
+    free(game_invent);
+    game_invent = items;
+    game_invent_icount = icount;
+    game_invent_changed = TRUE;
+}
+
+
 static char
 srv_query_key(const char *query, int *count)
 {
@@ -782,9 +1084,13 @@ reset_cached_diplaydata(void)
         free(prev_invent);
     prev_invent = NULL;
     prev_invent_icount = prev_floor_icount = 0;
+    /* game_invent mirrors the game's state, which survives this; the client
+       needs the whole list again, though */
+    game_invent_changed = (game_invent != NULL);
 
     memset(&player_info, 0, sizeof (player_info));
     memset(&prev_dbuf, 0, sizeof (prev_dbuf));
+    reset_screen_palette();
 }
 
 /* winprocs.c */